@@ -63,6 +63,9 @@ class Access(object):
                 self.nocomm = [nocomm]
             for v in self.nocomm:
                 v.begin_access()
+                # begin_access() does not mark v as modified; ghost
+                # updates of unmodified vectors are skipped
+                v.inc_state_counter()
         else:
             self.nocomm = None
 
@@ -73,6 +76,7 @@ class Access(object):
                 self.comm = [comm]
             for v in self.comm:
                 v.begin_access()
+                v.inc_state_counter()
         else:
             self.comm = None
 
@@ -83,11 +87,13 @@ class Access(object):
         if not self.nocomm is None:
             for v in self.nocomm:
                 v.end_access()
+                v.inc_state_counter()
             self.nocomm = None
 
         if not self.comm is None:
             for v in self.comm:
                 v.end_access()
+                v.inc_state_counter()
                 v.update_ghosts()
             self.comm = None
 
@@ -29,7 +29,7 @@ namespace pism {
 namespace calving {
 
 CalvingAtThickness::CalvingAtThickness(IceGrid::ConstPtr g)
-  : Component(g) {
+  : Component(g), m_front(g, 1) {
   m_calving_threshold = m_config->get_double("thickness_calving_threshold");
 
   m_old_mask.create(m_grid, "old_mask", WITH_GHOSTS, 1);
@@ -60,6 +60,9 @@ void CalvingAtThickness::update(IceModelVec2Int &pism_mask,
                                 IceModelVec2S &ice_thickness) {
   MaskQuery M(m_old_mask);
 
+  // only cells next to the calving front can be affected
+  m_front.update(pism_mask);
+
   // this call fills ghosts of m_old_mask
   m_old_mask.copy_from(pism_mask);
 
@@ -68,7 +71,7 @@ void CalvingAtThickness::update(IceModelVec2Int &pism_mask,
   list.add(ice_thickness);
   list.add(m_old_mask);
 
-  for (Points p(*m_grid); p; p.next()) {
+  for (CellListPoints p(m_front); p; p.next()) {
     const int i = p.i(), j = p.j();
 
     if (M.floating_ice(i, j)           &&
@@ -81,6 +84,7 @@ void CalvingAtThickness::update(IceModelVec2Int &pism_mask,
 
   pism_mask.update_ghosts();
   ice_thickness.update_ghosts();
+  pism_mask.inc_state_counter();
 }
 
 
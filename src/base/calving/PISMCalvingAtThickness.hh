@@ -22,6 +22,7 @@
 
 #include "base/util/PISMComponent.hh"
 #include "base/util/iceModelVec.hh"
+#include "PISMFrontIndex.hh"
 
 namespace pism {
 namespace calving {
@@ -45,6 +46,7 @@ protected:
 protected:
   double m_calving_threshold;
   IceModelVec2Int m_old_mask;
+  FrontIndex m_front;
 };
 
 } // end of namespace calving
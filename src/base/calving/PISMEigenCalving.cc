@@ -31,7 +31,7 @@ namespace calving {
 
 EigenCalving::EigenCalving(IceGrid::ConstPtr g,
                            stressbalance::StressBalance *stress_balance)
-  : Component(g), m_stencil_width(2),
+  : Component(g), m_front(g, 2), m_stencil_width(2),
     m_stress_balance(stress_balance) {
   m_strain_rates.create(m_grid, "edot", WITH_GHOSTS,
                         m_stencil_width,
@@ -89,6 +89,10 @@ void EigenCalving::update(double dt,
 
   update_strain_rates();
 
+  // Cells affected below are at most two cells away from the ice
+  // margin at the beginning of this call (see remove_narrow_tongues()).
+  m_front.update(pism_mask);
+
   MaskQuery mask(pism_mask);
 
   IceModelVec::AccessList list;
@@ -98,7 +102,7 @@ void EigenCalving::update(double dt,
   list.add(m_strain_rates);
   list.add(m_thk_loss);
 
-  for (Points pt(*m_grid); pt; pt.next()) {
+  for (CellListPoints pt(m_front); pt; pt.next()) {
     const int i = pt.i(), j = pt.j();
     // Average of strain-rate eigenvalues in adjacent floating grid
     // cells to be used for eigen-calving:
@@ -208,7 +212,7 @@ void EigenCalving::update(double dt,
 
   m_thk_loss.update_ghosts();
 
-  for (Points p(*m_grid); p; p.next()) {
+  for (CellListPoints p(m_front); p; p.next()) {
     const int i = p.i(), j = p.j();
     double thk_loss_ij = 0.0;
 
@@ -235,6 +239,7 @@ void EigenCalving::update(double dt,
 
   ice_thickness.update_ghosts();
   pism_mask.update_ghosts();
+  pism_mask.inc_state_counter();
 }
 
 
@@ -271,11 +276,13 @@ MaxTimestep EigenCalving::max_timestep() {
 
   update_strain_rates();
 
+  m_front.update(mask);
+
   IceModelVec::AccessList list;
   list.add(mask);
   list.add(m_strain_rates);
 
-  for (Points pt(*m_grid); pt; pt.next()) {
+  for (CellListPoints pt(m_front); pt; pt.next()) {
     const int i = pt.i(), j = pt.j();
     // Average of strain-rate eigenvalues in adjacent floating grid cells to
     // be used for eigencalving
@@ -411,6 +418,12 @@ void EigenCalving::update_strain_rates() {
  * This means that we can update `ice_thickness` in place without
  * introducing a dependence on the grid traversal order.
  *
+ * @note Only cells in `m_front` are visited. This is sufficient if
+ * `m_front` was built using the mask at the beginning of update():
+ * the code in update() removes cells next to the margin, so a cell
+ * that becomes a "nose" is at most two cells away from the original
+ * margin.
+ *
  * @param[in,out] pism_mask cell type mask
  * @param[in,out] ice_thickness modeled ice thickness
  *
@@ -424,7 +437,7 @@ void EigenCalving::remove_narrow_tongues(IceModelVec2Int &pism_mask,
   list.add(pism_mask);
   list.add(ice_thickness);
 
-  for (Points p(*m_grid); p; p.next()) {
+  for (CellListPoints p(m_front); p; p.next()) {
     const int i = p.i(), j = p.j();
     if (mask.ice_free(i, j)) {
       // FIXME: it might be better to have access to bedrock elevation b(i,j)
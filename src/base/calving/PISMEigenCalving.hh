@@ -21,6 +21,7 @@
 
 #include "base/util/iceModelVec.hh"
 #include "base/util/PISMComponent.hh"
+#include "PISMFrontIndex.hh"
 
 namespace pism {
 namespace stressbalance {
@@ -54,6 +55,8 @@ protected:
 protected:
   IceModelVec2 m_strain_rates;
   IceModelVec2S m_thk_loss;
+  //! cells near the calving front; all kernels below look at these only
+  FrontIndex m_front;
   const int m_stencil_width;
   stressbalance::StressBalance *m_stress_balance;
   double m_K;
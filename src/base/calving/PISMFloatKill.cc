@@ -66,6 +66,7 @@ void FloatKill::update(IceModelVec2Int &pism_mask, IceModelVec2S &ice_thickness)
 
   pism_mask.update_ghosts();
   ice_thickness.update_ghosts();
+  pism_mask.inc_state_counter();
 }
 
 void FloatKill::add_vars_to_output_impl(const std::string &/*keyword*/,
@@ -0,0 +1,82 @@
+/* Copyright (C) 2015 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "PISMFrontIndex.hh"
+#include "base/util/iceModelVec.hh"
+#include "base/util/Mask.hh"
+#include "base/util/error_handling.hh"
+
+namespace pism {
+namespace calving {
+
+FrontIndex::FrontIndex(IceGrid::ConstPtr g, unsigned int width)
+  : CellList(g, width), m_mask(NULL), m_mask_state(-1) {
+  // empty
+}
+
+//! True in icy cells.
+class Icy {
+public:
+  Icy(const IceModelVec2Int &mask)
+    : m_mask(mask) {
+    // empty
+  }
+
+  bool operator()(int i, int j) const {
+    return mask::icy(m_mask.as_int(i, j));
+  }
+private:
+  const IceModelVec2Int &m_mask;
+};
+
+/**
+ * Re-build the list of cells near the ice margin if `mask` changed.
+ *
+ * A cell is near the margin if the (2*width+1)x(2*width+1) window
+ * centered on it contains both icy and ice-free cells.
+ *
+ * Uses ghosts of `mask` (`width` of them).
+ *
+ * @param[in] mask cell type mask
+ */
+void FrontIndex::update(const IceModelVec2Int &mask) {
+  if (&mask == m_mask and mask.get_state_counter() == m_mask_state) {
+    return;
+  }
+
+  if (mask.get_stencil_width() < m_width) {
+    throw RuntimeError::formatted("the mask '%s' has stencil width %d, need %d",
+                                  mask.get_name().c_str(),
+                                  mask.get_stencil_width(), m_width);
+  }
+
+  const int
+    w      = m_width,
+    window = (2 * w + 1) * (2 * w + 1);
+
+  IceModelVec::AccessList list(mask);
+
+  build(Icy(mask), 1, window - 1);
+
+  m_mask       = &mask;
+  m_mask_state = mask.get_state_counter();
+}
+
+} // end of namespace calving
+} // end of namespace pism
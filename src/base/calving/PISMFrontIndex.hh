@@ -0,0 +1,65 @@
+/* Copyright (C) 2015 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _PISMFRONTINDEX_H_
+#define _PISMFRONTINDEX_H_
+
+#include "base/util/CellList.hh"
+
+namespace pism {
+
+class IceModelVec2Int;
+
+namespace calving {
+
+/*! \brief List of grid cells (owned by this processor) near the ice margin. */
+/*!
+ * A cell belongs to the list if there is at least one cell of the
+ * opposite kind (icy vs. ice-free) within `width` cells of it (in
+ * the max-norm).
+ *
+ * The list is re-built only when the state counter of the mask
+ * advances, so code modifying the mask has to call
+ * `inc_state_counter()`.
+ *
+ * Use it like this:
+ *
+ * @code
+ * front.update(mask);
+ * for (CellListPoints p(front); p; p.next()) {
+ *   const int i = p.i(), j = p.j();
+ *   // ...
+ * }
+ * @endcode
+ */
+class FrontIndex : public CellList {
+public:
+  FrontIndex(IceGrid::ConstPtr g, unsigned int width);
+
+  void update(const IceModelVec2Int &mask);
+private:
+  //! mask used to build the list and its state counter at that time
+  const IceModelVec2Int *m_mask;
+  int m_mask_state;
+};
+
+} // end of namespace calving
+} // end of namespace pism
+
+#endif /* _PISMFRONTINDEX_H_ */
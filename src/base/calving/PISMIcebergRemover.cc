@@ -146,6 +146,7 @@ void IcebergRemover::update(IceModelVec2Int &pism_mask,
   // elevation can be updated redundantly)
   pism_mask.update_ghosts();
   ice_thickness.update_ghosts();
+  pism_mask.inc_state_counter();
 }
 
 void IcebergRemover::add_vars_to_output_impl(const std::string &, std::set<std::string> &) {
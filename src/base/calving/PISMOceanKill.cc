@@ -97,27 +97,42 @@ void OceanKill::init() {
   }
 
   m_ocean_kill_mask.update_ghosts();
+
+  // The mask is time-independent, so we can find all the cells where
+  // the ice is removed once and visit only these in update().
+  m_kill_i.clear();
+  m_kill_j.clear();
+
+  unsigned int GHOSTS = m_ocean_kill_mask.get_stencil_width();
+  for (PointsWithGhosts p(*m_grid, GHOSTS); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    if (m_ocean_kill_mask(i, j) > 0.5) {
+      m_kill_i.push_back(i);
+      m_kill_j.push_back(j);
+    }
+  }
 }
 
 // Updates mask and ice thickness, including ghosts.
 void OceanKill::update(IceModelVec2Int &pism_mask, IceModelVec2S &ice_thickness) {
   IceModelVec::AccessList list;
-  list.add(m_ocean_kill_mask);
   list.add(pism_mask);
   list.add(ice_thickness);
 
+  // m_kill_i and m_kill_j include ghosts of m_ocean_kill_mask
   unsigned int GHOSTS = pism_mask.get_stencil_width();
-  assert(m_ocean_kill_mask.get_stencil_width() >= GHOSTS);
+  assert(m_ocean_kill_mask.get_stencil_width() == GHOSTS);
   assert(ice_thickness.get_stencil_width()     >= GHOSTS);
 
-  for (PointsWithGhosts p(*m_grid, GHOSTS); p; p.next()) {
-    const int i = p.i(), j = p.j();
+  for (unsigned int k = 0; k < m_kill_i.size(); ++k) {
+    const int i = m_kill_i[k], j = m_kill_j[k];
 
-    if (m_ocean_kill_mask(i, j) > 0.5) {
-      pism_mask(i, j)     = MASK_ICE_FREE_OCEAN;
-      ice_thickness(i, j) = 0.0;
-    }
+    pism_mask(i, j)     = MASK_ICE_FREE_OCEAN;
+    ice_thickness(i, j) = 0.0;
   }
+
+  pism_mask.inc_state_counter();
 }
 
 void OceanKill::add_vars_to_output_impl(const std::string &keyword, std::set<std::string> &result) {
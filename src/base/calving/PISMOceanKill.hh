@@ -23,6 +23,8 @@
 #include "base/util/PISMComponent.hh"
 #include "base/util/iceModelVec.hh"
 
+#include <vector>
+
 namespace pism {
 namespace calving {
 
@@ -49,6 +51,8 @@ protected:
                                      IO_Type nctype);
 protected:
   IceModelVec2Int m_ocean_kill_mask;
+  //! indices of cells (including ghosts) where m_ocean_kill_mask is set
+  std::vector<int> m_kill_i, m_kill_j;
 };
 
 } // end of namespace calving
@@ -53,6 +53,62 @@ Distributed::Distributed(IceGrid::ConstPtr g, stressbalance::StressBalance *sb)
   m_psi.set_attrs("internal",
                 "hydraulic potential of water in subglacial layer",
                 "Pa", "");
+
+  m_implicit_P = m_config->get_boolean("hydrology_distributed_implicit_pressure");
+  m_implicit_hdt = 0.0;
+
+  if (m_implicit_P) {
+    m_Tstag.create(m_grid, "T_staggered", WITH_GHOSTS, 1);
+    m_Tstag.set_attrs("internal",
+                      "cell face-centered (staggered) values of upwinded transmissivity K W",
+                      "m2 s-1 Pa-1", "");
+    m_P_iterate.create(m_grid, "P_iterate_internal", WITH_GHOSTS, 1);
+    m_P_iterate.set_attrs("internal",
+                          "water pressure during implicit update",
+                          "Pa", "");
+    m_P_source.create(m_grid, "P_source_internal", WITHOUT_GHOSTS);
+    m_P_source.set_attrs("internal",
+                         "terms of the water pressure equation which do not depend on pressure",
+                         "m s-1", "");
+    m_P_lower.create(m_grid, "P_lower_internal", WITHOUT_GHOSTS);
+    m_P_lower.set_attrs("internal", "lower bound on water pressure", "Pa", "");
+    m_P_upper.create(m_grid, "P_upper_internal", WITHOUT_GHOSTS);
+    m_P_upper.set_attrs("internal", "upper bound on water pressure", "Pa", "");
+
+    PetscErrorCode ierr;
+
+    m_P_da = m_grid->get_dm(1, 1);
+
+#if PETSC_VERSION_LT(3,5,0)
+    ierr = DMCreateMatrix(*m_P_da, MATAIJ, m_P_jacobian.rawptr());
+    PISM_CHK(ierr, "DMCreateMatrix");
+#else
+    ierr = DMSetMatType(*m_P_da, MATAIJ);
+    PISM_CHK(ierr, "DMSetMatType");
+
+    ierr = DMCreateMatrix(*m_P_da, m_P_jacobian.rawptr());
+    PISM_CHK(ierr, "DMCreateMatrix");
+#endif
+
+    ierr = SNESCreate(m_grid->com, m_P_snes.rawptr());
+    PISM_CHK(ierr, "SNESCreate");
+
+    ierr = SNESSetOptionsPrefix(m_P_snes, "hydrology_");
+    PISM_CHK(ierr, "SNESSetOptionsPrefix");
+
+    // the projection 0 <= P <= P_o is a constraint of the implicit problem
+    ierr = SNESSetType(m_P_snes, SNESVINEWTONRSLS);
+    PISM_CHK(ierr, "SNESSetType");
+
+    ierr = SNESSetFunction(m_P_snes, NULL, P_function_callback, this);
+    PISM_CHK(ierr, "SNESSetFunction");
+
+    ierr = SNESSetJacobian(m_P_snes, m_P_jacobian, m_P_jacobian, P_jacobian_callback, this);
+    PISM_CHK(ierr, "SNESSetJacobian");
+
+    ierr = SNESSetFromOptions(m_P_snes);
+    PISM_CHK(ierr, "SNESSetFromOptions");
+  }
 }
 
 Distributed::~Distributed() {
@@ -387,7 +443,14 @@ void Distributed::update_impl(double icet, double icedt) {
     advective_fluxes(m_Qstag);
     m_Qstag.update_ghosts();
 
-    adaptive_for_WandP_evolution(ht, m_t+m_dt, maxKW, hdt, maxV, maxD, PtoCFLratio);
+    if (m_implicit_P) {
+      // the P update is unconditionally stable; use the time step of hydrology::Routing
+      double dtCFL = 0.0, dtDIFFW = 0.0;
+      adaptive_for_W_evolution(ht, m_t+m_dt, maxKW, hdt, maxV, maxD, dtCFL, dtDIFFW);
+      PtoCFLratio = 1.0;
+    } else {
+      adaptive_for_WandP_evolution(ht, m_t+m_dt, maxKW, hdt, maxV, maxD, PtoCFLratio);
+    }
     cumratio += PtoCFLratio;
 
     if ((m_inputtobed != NULL) || (hydrocount==1)) {
@@ -404,61 +467,65 @@ void Distributed::update_impl(double icet, double icedt) {
     nullstriplost+= delta_nullstrip;
 
     // update Pnew from time step
-    const double  CC = (rg * hdt) / phi0,
-                     wux  = 1.0 / (m_dx * m_dx),
-                     wuy  = 1.0 / (m_dy * m_dy);
-    double  Open, Close, divflux, ZZ,
-               divadflux, diffW;
-    overburden_pressure(m_Pover);
-
-    const IceModelVec2Int *mask = m_grid->variables().get_2d_mask("mask");
-
-    MaskQuery M(*mask);
-
-    IceModelVec::AccessList list;
-    list.add(m_P);
-    list.add(m_W);
-    list.add(m_Wtil);
-    list.add(m_Wtilnew);
-    list.add(m_velbase_mag);
-    list.add(m_Wstag);
-    list.add(m_Kstag);
-    list.add(m_Qstag);
-    list.add(m_total_input);
-    list.add(*mask);
-    list.add(m_Pover);
-    list.add(m_Pnew);
-
-    for (Points p(*m_grid); p; p.next()) {
-      const int i = p.i(), j = p.j();
-
-      if (M.ice_free_land(i,j)) {
-        m_Pnew(i,j) = 0.0;
-      } else if (M.ocean(i,j)) {
-        m_Pnew(i,j) = m_Pover(i,j);
-      } else if (m_W(i,j) <= 0.0) {
-        m_Pnew(i,j) = m_Pover(i,j);
-      } else {
-        // opening and closure terms in pressure equation
-        Open = std::max(0.0,c1 * m_velbase_mag(i,j) * (Wr - m_W(i,j)));
-        Close = c2 * Aglen * pow(m_Pover(i,j) - m_P(i,j),nglen) * m_W(i,j);
-
-        // compute the flux divergence the same way as in raw_update_W()
-        divadflux =   (m_Qstag(i,j,0) - m_Qstag(i-1,j  ,0)) / m_dx
-          + (m_Qstag(i,j,1) - m_Qstag(i,  j-1,1)) / m_dy;
-        const double  De = rg * m_Kstag(i,  j,0) * m_Wstag(i,  j,0),
-          Dw = rg * m_Kstag(i-1,j,0) * m_Wstag(i-1,j,0),
-          Dn = rg * m_Kstag(i,j  ,1) * m_Wstag(i,j  ,1),
-          Ds = rg * m_Kstag(i,j-1,1) * m_Wstag(i,j-1,1);
-        diffW =   wux * (De * (m_W(i+1,j) - m_W(i,j)) - Dw * (m_W(i,j) - m_W(i-1,j)))
-          + wuy * (Dn * (m_W(i,j+1) - m_W(i,j)) - Ds * (m_W(i,j) - m_W(i,j-1)));
-        divflux = - divadflux + diffW;
-
-        // pressure update equation
-        ZZ = Close - Open + m_total_input(i,j) - (m_Wtilnew(i,j) - m_Wtil(i,j)) / hdt;
-        m_Pnew(i,j) = m_P(i,j) + CC * (divflux + ZZ);
-        // projection to enforce  0 <= P <= P_o
-        m_Pnew(i,j) = std::min(std::max(0.0, m_Pnew(i,j)), m_Pover(i,j));
+    if (m_implicit_P) {
+      update_P_implicit(hdt);
+    } else {
+      const double  CC = (rg * hdt) / phi0,
+                       wux  = 1.0 / (m_dx * m_dx),
+                       wuy  = 1.0 / (m_dy * m_dy);
+      double  Open, Close, divflux, ZZ,
+                 divadflux, diffW;
+      overburden_pressure(m_Pover);
+
+      const IceModelVec2Int *mask = m_grid->variables().get_2d_mask("mask");
+
+      MaskQuery M(*mask);
+
+      IceModelVec::AccessList list;
+      list.add(m_P);
+      list.add(m_W);
+      list.add(m_Wtil);
+      list.add(m_Wtilnew);
+      list.add(m_velbase_mag);
+      list.add(m_Wstag);
+      list.add(m_Kstag);
+      list.add(m_Qstag);
+      list.add(m_total_input);
+      list.add(*mask);
+      list.add(m_Pover);
+      list.add(m_Pnew);
+
+      for (Points p(*m_grid); p; p.next()) {
+        const int i = p.i(), j = p.j();
+
+        if (M.ice_free_land(i,j)) {
+          m_Pnew(i,j) = 0.0;
+        } else if (M.ocean(i,j)) {
+          m_Pnew(i,j) = m_Pover(i,j);
+        } else if (m_W(i,j) <= 0.0) {
+          m_Pnew(i,j) = m_Pover(i,j);
+        } else {
+          // opening and closure terms in pressure equation
+          Open = std::max(0.0,c1 * m_velbase_mag(i,j) * (Wr - m_W(i,j)));
+          Close = c2 * Aglen * pow(m_Pover(i,j) - m_P(i,j),nglen) * m_W(i,j);
+
+          // compute the flux divergence the same way as in raw_update_W()
+          divadflux =   (m_Qstag(i,j,0) - m_Qstag(i-1,j  ,0)) / m_dx
+            + (m_Qstag(i,j,1) - m_Qstag(i,  j-1,1)) / m_dy;
+          const double  De = rg * m_Kstag(i,  j,0) * m_Wstag(i,  j,0),
+            Dw = rg * m_Kstag(i-1,j,0) * m_Wstag(i-1,j,0),
+            Dn = rg * m_Kstag(i,j  ,1) * m_Wstag(i,j  ,1),
+            Ds = rg * m_Kstag(i,j-1,1) * m_Wstag(i,j-1,1);
+          diffW =   wux * (De * (m_W(i+1,j) - m_W(i,j)) - Dw * (m_W(i,j) - m_W(i-1,j)))
+            + wuy * (Dn * (m_W(i,j+1) - m_W(i,j)) - Ds * (m_W(i,j) - m_W(i,j-1)));
+          divflux = - divadflux + diffW;
+
+          // pressure update equation
+          ZZ = Close - Open + m_total_input(i,j) - (m_Wtilnew(i,j) - m_Wtil(i,j)) / hdt;
+          m_Pnew(i,j) = m_P(i,j) + CC * (divflux + ZZ);
+          // projection to enforce  0 <= P <= P_o
+          m_Pnew(i,j) = std::min(std::max(0.0, m_Pnew(i,j)), m_Pover(i,j));
+        }
       }
     }
 
@@ -495,6 +562,323 @@ void Distributed::update_impl(double icet, double icedt) {
 }
 
 
+//! Returns true if P at (i,j) is not evolved (and sets its value).
+/*!
+This is the case in ice-free and ocean areas and where there is no transportable
+water. Matches the explicit P update in update_impl().
+ */
+bool Distributed::P_is_fixed(MaskQuery &M, int i, int j, double &value) {
+  if (M.ice_free_land(i,j)) {
+    value = 0.0;
+    return true;
+  } else if (M.ocean(i,j) or m_W(i,j) <= 0.0) {
+    value = m_Pover(i,j);
+    return true;
+  }
+  return false;
+}
+
+
+//! Update P using a backward Euler step; puts the result in Pnew.
+/*!
+The explicit P update in update_impl() is limited by the time step
+restriction of the diffusion of P through the advective flux,
+\f$\Delta t \le 2 \phi_0 \Delta t_{W}\f$, where \f$\Delta t_{W}\f$ is the
+time step restriction of the diffusion of W. Here we solve
+\f[ \frac{\phi_0}{\rho_w g} \frac{P^{n+1} - P^n}{\Delta t} = \nabla \cdot \left(T \nabla (P^{n+1} + \rho_w g b)\right)
+    + \nabla \cdot (D \nabla W^n) + C(P^{n+1}) - O + \frac{m}{\rho_w} - \frac{\Delta W_{til}}{\Delta t}, \f]
+where the transmissivity \f$T = K W\f$ (with W upwinded using the current
+velocity), the diffusivity \f$D\f$ and the opening rate \f$O\f$ are
+evaluated at the beginning of the step and the closure rate
+\f$C(P) = c_2 A (P_o - P)^n W\f$ is implicit. The bounds
+\f$0 \le P \le P_o\f$ are imposed by using a variational inequality
+solver. W is still updated explicitly.
+
+Assumes that Wstag, Kstag, V, Wtil, Wtilnew and total_input are up to date.
+ */
+void Distributed::update_P_implicit(double hdt) {
+  const double
+    rg    = m_config->get_double("fresh_water_density") * m_config->get_double("standard_gravity"),
+    c1    = m_config->get_double("hydrology_cavitation_opening_coefficient"),
+    Wr    = m_config->get_double("hydrology_roughness_scale"),
+    wux   = 1.0 / (m_dx * m_dx),
+    wuy   = 1.0 / (m_dy * m_dy);
+
+  m_implicit_hdt = hdt;
+
+  overburden_pressure(m_Pover);
+
+  {
+    IceModelVec::AccessList list;
+    list.add(m_W);
+    list.add(m_V);
+    list.add(m_Wstag);
+    list.add(m_Kstag);
+    list.add(m_Tstag);
+
+    for (Points p(*m_grid); p; p.next()) {
+      const int i = p.i(), j = p.j();
+
+      // velocity_staggered() sets V to zero in these cases
+      const bool
+        east_active  = (m_Wstag(i,j,0) > 0.0 and
+                        not (in_null_strip(*m_grid, i,j, m_stripwidth) or
+                             in_null_strip(*m_grid, i+1,j, m_stripwidth))),
+        north_active = (m_Wstag(i,j,1) > 0.0 and
+                        not (in_null_strip(*m_grid, i,j, m_stripwidth) or
+                             in_null_strip(*m_grid, i,j+1, m_stripwidth)));
+
+      m_Tstag(i,j,0) = (east_active ?
+                        m_Kstag(i,j,0) * (m_V(i,j,0) >= 0.0 ? m_W(i,j) : m_W(i+1,j)) :
+                        0.0);
+      m_Tstag(i,j,1) = (north_active ?
+                        m_Kstag(i,j,1) * (m_V(i,j,1) >= 0.0 ? m_W(i,j) : m_W(i,j+1)) :
+                        0.0);
+    }
+  }
+  m_Tstag.update_ghosts();
+
+  {
+    IceModelVec::AccessList list;
+    list.add(m_W);
+    list.add(m_Wtil);
+    list.add(m_Wtilnew);
+    list.add(m_velbase_mag);
+    list.add(m_Wstag);
+    list.add(m_Kstag);
+    list.add(m_total_input);
+    list.add(m_P_source);
+
+    for (Points p(*m_grid); p; p.next()) {
+      const int i = p.i(), j = p.j();
+
+      const double
+        Open = std::max(0.0,c1 * m_velbase_mag(i,j) * (Wr - m_W(i,j))),
+        De   = rg * m_Kstag(i,  j,0) * m_Wstag(i,  j,0),
+        Dw   = rg * m_Kstag(i-1,j,0) * m_Wstag(i-1,j,0),
+        Dn   = rg * m_Kstag(i,j  ,1) * m_Wstag(i,j  ,1),
+        Ds   = rg * m_Kstag(i,j-1,1) * m_Wstag(i,j-1,1),
+        diffW = (wux * (De * (m_W(i+1,j) - m_W(i,j)) - Dw * (m_W(i,j) - m_W(i-1,j))) +
+                 wuy * (Dn * (m_W(i,j+1) - m_W(i,j)) - Ds * (m_W(i,j) - m_W(i,j-1))));
+
+      m_P_source(i,j) = (diffW - Open + m_total_input(i,j)
+                         - (m_Wtilnew(i,j) - m_Wtil(i,j)) / hdt);
+    }
+  }
+
+  m_P_lower.set(0.0);
+  m_P_upper.copy_from(m_Pover);
+
+  // initial guess: P at the beginning of the step (within bounds; see
+  // check_P_bounds())
+  m_Pnew.copy_from(m_P);
+
+  PetscErrorCode ierr;
+
+  ierr = SNESVISetVariableBounds(m_P_snes, m_P_lower.get_vec(), m_P_upper.get_vec());
+  PISM_CHK(ierr, "SNESVISetVariableBounds");
+
+  ierr = SNESSolve(m_P_snes, NULL, m_Pnew.get_vec());
+  PISM_CHK(ierr, "SNESSolve");
+
+  SNESConvergedReason reason;
+  ierr = SNESGetConvergedReason(m_P_snes, &reason);
+  PISM_CHK(ierr, "SNESGetConvergedReason");
+
+  if (reason < 0) {
+    throw RuntimeError::formatted("hydrology::Distributed: implicit pressure update failed"
+                                  " to converge (SNES reason %s)",
+                                  SNESConvergedReasons[reason]);
+  }
+
+  PetscInt iterations = 0;
+  ierr = SNESGetIterationNumber(m_P_snes, &iterations);
+  PISM_CHK(ierr, "SNESGetIterationNumber");
+
+  m_log->message(4,
+                 "    implicit P update took %d Newton iterations (SNES reason %s)\n",
+                 (int)iterations, SNESConvergedReasons[reason]);
+
+  m_Pnew.inc_state_counter();
+}
+
+
+//! Compute the residual of the implicit P update (see update_P_implicit()).
+void Distributed::P_residual(const IceModelVec2S &P, double **result) {
+  const double
+    rg    = m_config->get_double("fresh_water_density") * m_config->get_double("standard_gravity"),
+    nglen = m_config->get_double("sia_Glen_exponent"), // choice is SIA; see #285
+    Aglen = m_config->get_double("ice_softness"),
+    c2    = m_config->get_double("hydrology_creep_closure_coefficient"),
+    phi0  = m_config->get_double("hydrology_regularizing_porosity"),
+    CC    = (rg * m_implicit_hdt) / phi0;
+
+  const IceModelVec2S *bed = m_grid->variables().get_2d_scalar("bedrock_altitude");
+  const IceModelVec2Int *mask = m_grid->variables().get_2d_mask("mask");
+  MaskQuery M(*mask);
+
+  IceModelVec::AccessList list;
+  list.add(P);
+  list.add(m_P);
+  list.add(m_W);
+  list.add(m_Tstag);
+  list.add(m_P_source);
+  list.add(m_Pover);
+  list.add(*bed);
+  list.add(*mask);
+
+  for (Points p(*m_grid); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    double P_fixed = 0.0;
+    if (P_is_fixed(M, i, j, P_fixed)) {
+      result[i][j] = P(i,j) - P_fixed;
+      continue;
+    }
+
+    // flux -T grad(P + rho_w g b) at the four faces
+    const double
+      R   = P(i,j) + rg * (*bed)(i,j),
+      q_e = m_Tstag(i,  j,0) * (P(i+1,j) + rg * (*bed)(i+1,j) - R) / m_dx,
+      q_w = m_Tstag(i-1,j,0) * (R - P(i-1,j) - rg * (*bed)(i-1,j)) / m_dx,
+      q_n = m_Tstag(i,j,  1) * (P(i,j+1) + rg * (*bed)(i,j+1) - R) / m_dy,
+      q_s = m_Tstag(i,j-1,1) * (R - P(i,j-1) - rg * (*bed)(i,j-1)) / m_dy,
+      div_q = (q_e - q_w) / m_dx + (q_n - q_s) / m_dy,
+      Close = c2 * Aglen * pow(std::max(m_Pover(i,j) - P(i,j), 0.0), nglen) * m_W(i,j);
+
+    result[i][j] = P(i,j) - m_P(i,j) - CC * (div_q + Close + m_P_source(i,j));
+  }
+}
+
+
+//! Compute the Jacobian of the implicit P update (see update_P_implicit()).
+void Distributed::P_jacobian(const IceModelVec2S &P, Mat J) {
+  const double
+    rg    = m_config->get_double("fresh_water_density") * m_config->get_double("standard_gravity"),
+    nglen = m_config->get_double("sia_Glen_exponent"), // choice is SIA; see #285
+    Aglen = m_config->get_double("ice_softness"),
+    c2    = m_config->get_double("hydrology_creep_closure_coefficient"),
+    phi0  = m_config->get_double("hydrology_regularizing_porosity"),
+    CC    = (rg * m_implicit_hdt) / phi0,
+    wux   = 1.0 / (m_dx * m_dx),
+    wuy   = 1.0 / (m_dy * m_dy);
+
+  PetscErrorCode ierr;
+
+  ierr = MatZeroEntries(J);
+  PISM_CHK(ierr, "MatZeroEntries");
+
+  const IceModelVec2Int *mask = m_grid->variables().get_2d_mask("mask");
+  MaskQuery M(*mask);
+
+  IceModelVec::AccessList list;
+  list.add(P);
+  list.add(m_W);
+  list.add(m_Tstag);
+  list.add(m_Pover);
+  list.add(*mask);
+
+  for (Points p(*m_grid); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    MatStencil row, col[5];
+    double values[5];
+    int N = 0;
+
+    // PISM's i corresponds to PETSc's j and vice versa (see IceGrid::create_dm())
+    row.j = i;
+    row.i = j;
+
+    double P_fixed = 0.0;
+    if (P_is_fixed(M, i, j, P_fixed)) {
+      col[0] = row;
+      values[0] = 1.0;
+      N = 1;
+    } else {
+      const double
+        T_e = CC * wux * m_Tstag(i,  j,0),
+        T_w = CC * wux * m_Tstag(i-1,j,0),
+        T_n = CC * wuy * m_Tstag(i,j,  1),
+        T_s = CC * wuy * m_Tstag(i,j-1,1),
+        dClose = (c2 * Aglen * nglen * m_W(i,j) *
+                  pow(std::max(m_Pover(i,j) - P(i,j), 0.0), nglen - 1.0));
+
+      const int I[5] = {i, i + 1, i - 1, i, i};
+      const int Jj[5] = {j, j, j, j + 1, j - 1};
+      const double v[5] = {1.0 + T_e + T_w + T_n + T_s + CC * dClose,
+                           -T_e, -T_w, -T_n, -T_s};
+
+      for (int k = 0; k < 5; ++k) {
+        col[k].j  = I[k];
+        col[k].i  = Jj[k];
+        values[k] = v[k];
+      }
+      N = 5;
+    }
+
+    ierr = MatSetValuesStencil(J, 1, &row, N, col, values, INSERT_VALUES);
+    PISM_CHK(ierr, "MatSetValuesStencil");
+  }
+
+  ierr = MatAssemblyBegin(J, MAT_FINAL_ASSEMBLY);
+  PISM_CHK(ierr, "MatAssemblyBegin");
+
+  ierr = MatAssemblyEnd(J, MAT_FINAL_ASSEMBLY);
+  PISM_CHK(ierr, "MatAssemblyEnd");
+}
+
+
+PetscErrorCode Distributed::P_function_callback(SNES snes, Vec P, Vec F, void *ctx) {
+  Distributed *model = reinterpret_cast<Distributed*>(ctx);
+  try {
+    (void) snes;
+    model->m_P_iterate.copy_from_vec(P);
+
+    petsc::DMDAVecArray F_array(model->m_Pnew.get_dm(), F);
+    model->P_residual(model->m_P_iterate, static_cast<double**>(F_array.get()));
+  } catch (...) {
+    MPI_Comm com = model->m_grid->com;
+    handle_fatal_errors(com);
+    SETERRQ(com, 1, "A PISM callback failed");
+  }
+  return 0;
+}
+
+#if PETSC_VERSION_LT(3,5,0)
+PetscErrorCode Distributed::P_jacobian_callback(SNES snes, Vec P, Mat *A, Mat *J,
+                                                MatStructure *str, void *ctx) {
+  Distributed *model = reinterpret_cast<Distributed*>(ctx);
+  try {
+    (void) snes;
+    (void) A;
+    model->m_P_iterate.copy_from_vec(P);
+    model->P_jacobian(model->m_P_iterate, *J);
+    *str = SAME_NONZERO_PATTERN;
+  } catch (...) {
+    MPI_Comm com = model->m_grid->com;
+    handle_fatal_errors(com);
+    SETERRQ(com, 1, "A PISM callback failed");
+  }
+  return 0;
+}
+#else
+PetscErrorCode Distributed::P_jacobian_callback(SNES snes, Vec P, Mat A, Mat J, void *ctx) {
+  Distributed *model = reinterpret_cast<Distributed*>(ctx);
+  try {
+    (void) snes;
+    (void) A;
+    model->m_P_iterate.copy_from_vec(P);
+    model->P_jacobian(model->m_P_iterate, J);
+  } catch (...) {
+    MPI_Comm com = model->m_grid->com;
+    handle_fatal_errors(com);
+    SETERRQ(com, 1, "A PISM callback failed");
+  }
+  return 0;
+}
+#endif
+
+
 Distributed_hydrovelbase_mag::Distributed_hydrovelbase_mag(Distributed *m)
   : Diag<Distributed>(m) {
   m_vars.push_back(SpatialVariableMetadata(m_sys,
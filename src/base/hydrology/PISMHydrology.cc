@@ -28,12 +28,19 @@
 namespace pism {
 namespace hydrology {
 
-Hydrology::Hydrology(IceGrid::ConstPtr g)
+/*!
+ * @param[in] g computational grid
+ * @param[in] stencil_width number of ghosts of `tillwat` and
+ *            `total_input` (zero if derived classes do not need them)
+ */
+Hydrology::Hydrology(IceGrid::ConstPtr g, unsigned int stencil_width)
   : Component_TS(g) {
   m_inputtobed = NULL;
   m_hold_bmelt = false;
 
-  m_total_input.create(m_grid, "total_input", WITHOUT_GHOSTS);
+  const IceModelVecKind ghosted = stencil_width > 0 ? WITH_GHOSTS : WITHOUT_GHOSTS;
+
+  m_total_input.create(m_grid, "total_input", ghosted, stencil_width);
   m_total_input.set_attrs("internal",
                         "hydrology model workspace for total input rate into subglacial water layer",
                         "m s-1", "");
@@ -44,7 +51,7 @@ Hydrology::Hydrology(IceGrid::ConstPtr g)
                         "m s-1", "");
 
   // *all* Hydrology classes have layer of water stored in till as a state variable
-  m_Wtil.create(m_grid, "tillwat", WITHOUT_GHOSTS);
+  m_Wtil.create(m_grid, "tillwat", ghosted, stencil_width);
   m_Wtil.set_attrs("model_state",
                  "effective thickness of subglacial water stored in till",
                  "m", "");
@@ -21,10 +21,13 @@
 
 #include "base/util/iceModelVec.hh"
 #include "base/util/PISMComponent.hh"
+#include "base/util/petscwrappers/SNES.hh"
+#include "base/util/petscwrappers/Mat.hh"
 
 namespace pism {
 
 class IceModelVec2T;
+class MaskQuery;
 
 namespace stressbalance {
 class StressBalance;
@@ -100,7 +103,7 @@ namespace hydrology {
 */
 class Hydrology : public Component_TS {
 public:
-  Hydrology(IceGrid::ConstPtr g);
+  Hydrology(IceGrid::ConstPtr g, unsigned int stencil_width = 0);
   virtual ~Hydrology();
 
   virtual void init();
@@ -287,7 +290,8 @@ protected:
   // is needed; we update the new thickness variable, a temporary during update
   virtual void boundary_mass_changes(IceModelVec2S &newthk,
                                      double &icefreelost, double &oceanlost,
-                                     double &negativegain, double &nullstriplost);
+                                     double &negativegain, double &nullstriplost,
+                                     unsigned int width = 0);
 
   double m_ice_free_land_loss_cumulative,
          m_ocean_loss_cumulative,
@@ -296,23 +300,37 @@ protected:
 
   virtual void check_water_thickness_nonnegative(IceModelVec2S &thk);
 
-  virtual void water_thickness_staggered(IceModelVec2Stag &result);
+  // the optional argument "width" of methods below is the number of ghost
+  // points to compute values at (in addition to owned points); see update_impl()
+  virtual void water_thickness_staggered(IceModelVec2Stag &result, unsigned int width = 0);
   virtual void subglacial_hydraulic_potential(IceModelVec2S &result);
 
-  virtual void conductivity_staggered(IceModelVec2Stag &result, double &maxKW);
-  virtual void velocity_staggered(IceModelVec2Stag &result);
+  virtual void conductivity_staggered(IceModelVec2Stag &result, double &maxKW,
+                                      unsigned int width = 0);
+  virtual void velocity_staggered(IceModelVec2Stag &result, unsigned int width = 0);
   friend class Routing_bwatvel;  // needed because bwatvel diagnostic needs protected velocity_staggered()
-  virtual void advective_fluxes(IceModelVec2Stag &result);
+  virtual void advective_fluxes(IceModelVec2Stag &result, unsigned int width = 0);
 
   virtual void adaptive_for_W_evolution(double t_current, double t_end, double maxKW,
                                         double &dt_result,
                                         double &maxV_result, double &maxD_result,
                                         double &dtCFL_result, double &dtDIFFW_result);
 
-  void raw_update_W(double hdt);
-  void raw_update_Wtil(double hdt);
+  void raw_update_W(double hdt, unsigned int width = 0);
+  template <class Iterator>
+  void raw_update_W(Iterator p, double hdt);
+  void raw_update_Wtil(double hdt, unsigned int width = 0);
+
+  void update_wide_fields();
 protected:
   double m_dx, m_dy;
+
+  //! stencil width used to take several sub-steps per ghost update (zero if
+  //! `hydrology_routing_substeps_per_ghost_update` is 1)
+  unsigned int m_wide_stencil_width;
+  //! copies of the mask and bed elevation with `m_wide_stencil_width` ghosts
+  IceModelVec2Int m_mask_wide;
+  IceModelVec2S m_bed_wide;
 };
 
 //! \brief The PISM subglacial hydrology model for a distributed linked-cavity system.
@@ -361,6 +379,11 @@ protected:
                                             double &dt_result,
                                             double &maxV_result, double &maxD_result,
                                             double &PtoCFLratio);
+
+  void update_P_implicit(double hdt);
+  void P_residual(const IceModelVec2S &P, double **result);
+  void P_jacobian(const IceModelVec2S &P, Mat J);
+  bool P_is_fixed(MaskQuery &M, int i, int j, double &value);
 protected:
   // this model's state, in addition to what is in hydrology::Routing
   IceModelVec2S m_P;      //!< water pressure
@@ -372,6 +395,25 @@ protected:
 
   // need to get basal sliding velocity (thus speed):
   stressbalance::StressBalance* m_stressbalance;
+
+  // implicit (backward Euler) P update; used if hydrology_distributed_implicit_pressure is set
+  bool m_implicit_P;
+  double m_implicit_hdt;     //!< time step of the current implicit P update
+  IceModelVec2Stag m_Tstag;  //!< face-centered transmissivity (upwinded K W)
+  IceModelVec2S m_P_iterate, //!< current SNES iterate (with ghosts)
+    m_P_source,              //!< terms of the P equation which do not depend on P
+    m_P_lower, m_P_upper;    //!< bounds on P
+  petsc::DM::Ptr m_P_da;
+  petsc::Mat m_P_jacobian;
+  petsc::SNES m_P_snes;
+
+  static PetscErrorCode P_function_callback(SNES snes, Vec P, Vec F, void *ctx);
+#if PETSC_VERSION_LT(3,5,0)
+  static PetscErrorCode P_jacobian_callback(SNES snes, Vec P, Mat *A, Mat *J,
+                                            MatStructure *str, void *ctx);
+#else
+  static PetscErrorCode P_jacobian_callback(SNES snes, Vec P, Mat A, Mat J, void *ctx);
+#endif
 };
 
 } // end of namespace hydrology
@@ -28,11 +28,39 @@
 namespace pism {
 namespace hydrology {
 
+//! Stencil width needed to take `hydrology_routing_substeps_per_ghost_update` sub-steps
+//! per ghost update; zero if this mechanism is not used.
+static unsigned int wide_stencil_width(IceGrid::ConstPtr g) {
+  const int N = g->ctx()->config()->get_double("hydrology_routing_substeps_per_ghost_update");
+
+  if (N < 1) {
+    throw RuntimeError::formatted("hydrology_routing_substeps_per_ghost_update = %d is invalid"
+                                  " (has to be 1 or greater)", N);
+  }
+
+  return N > 1 ? N + 1 : 0;
+}
+
+//! Returns true if the point (i,j) is owned by this processor.
+static inline bool owned(const IceGrid &grid, int i, int j) {
+  return (i >= grid.xs() and i < grid.xs() + grid.xm() and
+          j >= grid.ys() and j < grid.ys() + grid.ym());
+}
+
 Routing::Routing(IceGrid::ConstPtr g)
-  : Hydrology(g), m_dx(g->dx()), m_dy(g->dy())
+  : Hydrology(g, wide_stencil_width(g)), m_dx(g->dx()), m_dy(g->dy()),
+    m_wide_stencil_width(wide_stencil_width(g))
 {
   m_stripwidth = m_config->get_double("hydrology_null_strip_width");
 
+  // Fields below need more ghosts if we take several sub-steps per ghost
+  // update. (Staggered fields and V are computed on a region one cell
+  // narrower than W.)
+  const unsigned int
+    W_width    = m_wide_stencil_width > 0 ? m_wide_stencil_width : 1,
+    stag_width = m_wide_stencil_width > 0 ? m_wide_stencil_width - 1 : 1;
+  const IceModelVecKind ghosted = m_wide_stencil_width > 0 ? WITH_GHOSTS : WITHOUT_GHOSTS;
+
   // these variables are also set to zero every time init() is called
   m_ice_free_land_loss_cumulative      = 0.0;
   m_ocean_loss_cumulative              = 0.0;
@@ -40,54 +68,63 @@ Routing::Routing(IceGrid::ConstPtr g)
   m_null_strip_loss_cumulative         = 0.0;
 
   // model state variables; need ghosts
-  m_W.create(m_grid, "bwat", WITH_GHOSTS, 1);
+  m_W.create(m_grid, "bwat", WITH_GHOSTS, W_width);
   m_W.set_attrs("model_state",
               "thickness of transportable subglacial water layer",
               "m", "");
   m_W.metadata().set_double("valid_min", 0.0);
 
   // auxiliary variables which NEED ghosts
-  m_Wstag.create(m_grid, "W_staggered", WITH_GHOSTS, 1);
+  m_Wstag.create(m_grid, "W_staggered", WITH_GHOSTS, stag_width);
   m_Wstag.set_attrs("internal",
                   "cell face-centered (staggered) values of water layer thickness",
                   "m", "");
   m_Wstag.metadata().set_double("valid_min", 0.0);
-  m_Kstag.create(m_grid, "K_staggered", WITH_GHOSTS, 1);
+  m_Kstag.create(m_grid, "K_staggered", WITH_GHOSTS, stag_width);
   m_Kstag.set_attrs("internal",
                   "cell face-centered (staggered) values of nonlinear conductivity",
                   "", "");
   m_Kstag.metadata().set_double("valid_min", 0.0);
-  m_Qstag.create(m_grid, "advection_flux", WITH_GHOSTS, 1);
+  m_Qstag.create(m_grid, "advection_flux", WITH_GHOSTS, stag_width);
   m_Qstag.set_attrs("internal",
                   "cell face-centered (staggered) components of advective subglacial water flux",
                   "m2 s-1", "");
-  m_R.create(m_grid, "potential_workspace", WITH_GHOSTS, 1); // box stencil used
+  m_R.create(m_grid, "potential_workspace", WITH_GHOSTS, W_width); // box stencil used
   m_R.set_attrs("internal",
               "work space for modeled subglacial water hydraulic potential",
               "Pa", "");
 
-  // auxiliary variables which do not need ghosts
-  m_Pover.create(m_grid, "overburden_pressure_internal", WITHOUT_GHOSTS);
+  // auxiliary variables which do not need ghosts (unless several sub-steps
+  // are taken per ghost update)
+  m_Pover.create(m_grid, "overburden_pressure_internal", ghosted, m_wide_stencil_width);
   m_Pover.set_attrs("internal",
                   "overburden pressure",
                   "Pa", "");
   m_Pover.metadata().set_double("valid_min", 0.0);
-  m_V.create(m_grid, "water_velocity", WITHOUT_GHOSTS);
+  m_V.create(m_grid, "water_velocity", ghosted, stag_width);
   m_V.set_attrs("internal",
               "cell face-centered (staggered) components of water velocity in subglacial water layer",
               "m s-1", "");
 
-  // temporaries during update; do not need ghosts
-  m_Wnew.create(m_grid, "Wnew_internal", WITHOUT_GHOSTS);
+  // temporaries during update; do not need ghosts (see above)
+  m_Wnew.create(m_grid, "Wnew_internal", ghosted, m_wide_stencil_width);
   m_Wnew.set_attrs("internal",
                  "new thickness of transportable subglacial water layer during update",
                  "m", "");
   m_Wnew.metadata().set_double("valid_min", 0.0);
-  m_Wtilnew.create(m_grid, "Wtilnew_internal", WITHOUT_GHOSTS);
+  m_Wtilnew.create(m_grid, "Wtilnew_internal", ghosted, m_wide_stencil_width);
   m_Wtilnew.set_attrs("internal",
                     "new thickness of till (subglacial) water layer during update",
                     "m", "");
   m_Wtilnew.metadata().set_double("valid_min", 0.0);
+
+  if (m_wide_stencil_width > 0) {
+    m_mask_wide.create(m_grid, "mask_internal", WITH_GHOSTS, m_wide_stencil_width);
+    m_mask_wide.set_attrs("internal", "copy of the cell type mask", "", "");
+
+    m_bed_wide.create(m_grid, "topg_internal", WITH_GHOSTS, m_wide_stencil_width);
+    m_bed_wide.set_attrs("internal", "copy of the bedrock surface elevation", "m", "");
+  }
 }
 
 Routing::~Routing() {
@@ -230,15 +267,21 @@ processed.  This method takes alters the "new" field newthk in-place and sums
 the boundary removals.
 
 This method does no reporting at stdout; the calling routine can do that.
+
+If `width` is positive, newthk is corrected in `width` ghost points as
+well, but only owned points contribute to the sums.
  */
 void Routing::boundary_mass_changes(IceModelVec2S &newthk,
                                              double &icefreelost, double &oceanlost,
-                                             double &negativegain, double &nullstriplost) {
+                                             double &negativegain, double &nullstriplost,
+                                             unsigned int width) {
   double fresh_water_density = m_config->get_double("fresh_water_density");
   double my_icefreelost = 0.0, my_oceanlost = 0.0, my_negativegain = 0.0;
 
   const IceModelVec2S *cellarea = m_grid->variables().get_2d_scalar("cell_area");
-  const IceModelVec2Int *mask = m_grid->variables().get_2d_mask("mask");
+  const IceModelVec2Int *mask = (width > 0 ?
+                                 &m_mask_wide :
+                                 m_grid->variables().get_2d_mask("mask"));
 
   MaskQuery M(*mask);
 
@@ -247,10 +290,12 @@ void Routing::boundary_mass_changes(IceModelVec2S &newthk,
   list.add(*cellarea);
   list.add(*mask);
 
-  for (Points p(*m_grid); p; p.next()) {
+  for (PointsWithGhosts p(*m_grid, width); p; p.next()) {
     const int i = p.i(), j = p.j();
 
-    const double dmassdz = (*cellarea)(i,j) * fresh_water_density; // kg m-1
+    // cell_area does not have ghosts; values computed at ghost points are not used
+    const double dmassdz = (width == 0 or owned(*m_grid, i, j) ?
+                            (*cellarea)(i,j) * fresh_water_density : 0.0); // kg m-1
     if (newthk(i,j) < 0.0) {
       my_negativegain += -newthk(i,j) * dmassdz;
       newthk(i,j) = 0.0;
@@ -276,10 +321,11 @@ void Routing::boundary_mass_changes(IceModelVec2S &newthk,
   }
 
   double my_nullstriplost = 0.0;
-  for (Points p(*m_grid); p; p.next()) {
+  for (PointsWithGhosts p(*m_grid, width); p; p.next()) {
     const int i = p.i(), j = p.j();
 
-    const double dmassdz = (*cellarea)(i,j) * fresh_water_density; // kg m-1
+    const double dmassdz = (width == 0 or owned(*m_grid, i, j) ?
+                            (*cellarea)(i,j) * fresh_water_density : 0.0); // kg m-1
     if (in_null_strip(*m_grid, i, j, m_stripwidth)) {
       my_nullstriplost += newthk(i,j) * dmassdz;
       newthk(i,j) = 0.0;
@@ -340,10 +386,14 @@ void Routing::subglacial_hydraulic_potential(IceModelVec2S &result) {
 
 //! Average the regular grid water thickness to values at the center of cell edges.
 /*! Uses mask values to avoid averaging using water thickness values from
-either ice-free or floating areas. */
-void Routing::water_thickness_staggered(IceModelVec2Stag &result) {
+either ice-free or floating areas.
 
-  const IceModelVec2Int *mask = m_grid->variables().get_2d_mask("mask");
+If `width` is positive, uses the copy of the mask made by update_wide_fields(). */
+void Routing::water_thickness_staggered(IceModelVec2Stag &result, unsigned int width) {
+
+  const IceModelVec2Int *mask = (width > 0 ?
+                                 &m_mask_wide :
+                                 m_grid->variables().get_2d_mask("mask"));
   MaskQuery M(*mask);
 
   IceModelVec::AccessList list;
@@ -351,7 +401,9 @@ void Routing::water_thickness_staggered(IceModelVec2Stag &result) {
   list.add(m_W);
   list.add(result);
 
-  for (Points p(*m_grid); p; p.next()) {
+  assert(m_W.get_stencil_width() >= width + 1);
+
+  for (PointsWithGhosts p(*m_grid, width); p; p.next()) {
     const int i = p.i(), j = p.j();
 
     // east
@@ -396,9 +448,12 @@ by a [\ref Mahaffy] -like scheme.  This requires \f$R\f$ to be defined on a box
 stencil of width 1.
 
 Also returns the maximum over all staggered points of \f$ K W \f$.
+
+If `width` is positive, uses \f$R\f$ computed by update_wide_fields().
  */
 void Routing::conductivity_staggered(IceModelVec2Stag &result,
-                                                        double &maxKW) {
+                                                        double &maxKW,
+                                                        unsigned int width) {
   const double
     k     = m_config->get_double("hydrology_hydraulic_conductivity"),
     alpha = m_config->get_double("hydrology_thickness_power_in_flux"),
@@ -416,12 +471,14 @@ void Routing::conductivity_staggered(IceModelVec2Stag &result,
   // the squared norm of the gradient of the simplified hydrolic potential
   // temporarily in "result"
   if (beta != 2.0) {
-    subglacial_water_pressure(m_R);  // yes, it updates ghosts
-    m_R.add(rg, *bed); // R  <-- P + rhow g b
-    m_R.update_ghosts();
+    if (width == 0) {
+      subglacial_water_pressure(m_R);  // yes, it updates ghosts
+      m_R.add(rg, *bed); // R  <-- P + rhow g b
+      m_R.update_ghosts();
+    }
 
     list.add(m_R);
-    for (Points p(*m_grid); p; p.next()) {
+    for (PointsWithGhosts p(*m_grid, width); p; p.next()) {
       const int i = p.i(), j = p.j();
 
       double dRdx, dRdy;
@@ -437,9 +494,11 @@ void Routing::conductivity_staggered(IceModelVec2Stag &result,
   double betapow = (beta-2.0)/2.0, mymaxKW = 0.0;
 
   list.add(m_Wstag);
-  for (Points p(*m_grid); p; p.next()) {
+  for (PointsWithGhosts p(*m_grid, width); p; p.next()) {
     const int i = p.i(), j = p.j();
 
+    const bool is_owned = width == 0 or owned(*m_grid, i, j);
+
     for (int o = 0; o < 2; ++o) {
       double Ktmp = k * pow(m_Wstag(i,j,o),alpha-1.0);
       if (beta < 2.0) {
@@ -452,7 +511,9 @@ void Routing::conductivity_staggered(IceModelVec2Stag &result,
       } else { // beta == 2.0
         result(i,j,o) = Ktmp;
       }
-      mymaxKW = std::max(mymaxKW, result(i,j,o) * m_Wstag(i,j,o));
+      if (is_owned) {
+        mymaxKW = std::max(mymaxKW, result(i,j,o) * m_Wstag(i,j,o));
+      }
     }
   }
 
@@ -546,28 +607,36 @@ would be zero anyway) but it does provide the correct max velocity in the
 CFL calculation.  We assume Wstag and Kstag are up-to-date.  We assume P and b
 have valid ghosts.
 
-Calls subglacial_water_pressure() method to get water pressure.
+Calls subglacial_water_pressure() method to get water pressure. If
+`width` is positive, uses pressure and bed elevation prepared by
+update_wide_fields() instead.
  */
-void Routing::velocity_staggered(IceModelVec2Stag &result) {
+void Routing::velocity_staggered(IceModelVec2Stag &result, unsigned int width) {
   const double  rg = m_config->get_double("standard_gravity") * m_config->get_double("fresh_water_density");
   double dbdx, dbdy, dPdx, dPdy;
 
-  subglacial_water_pressure(m_R);  // R=P; yes, it updates ghosts
-
-  const IceModelVec2S *bed = m_grid->variables().get_2d_scalar("bedrock_altitude");
+  const IceModelVec2S *P = NULL, *bed = NULL;
+  if (width == 0) {
+    subglacial_water_pressure(m_R);  // R=P; yes, it updates ghosts
+    P   = &m_R;
+    bed = m_grid->variables().get_2d_scalar("bedrock_altitude");
+  } else {
+    P   = &m_Pover;
+    bed = &m_bed_wide;
+  }
 
   IceModelVec::AccessList list;
-  list.add(m_R);
+  list.add(*P);
   list.add(m_Wstag);
   list.add(m_Kstag);
   list.add(*bed);
   list.add(result);
 
-  for (Points p(*m_grid); p; p.next()) {
+  for (PointsWithGhosts p(*m_grid, width); p; p.next()) {
     const int i = p.i(), j = p.j();
 
     if (m_Wstag(i,j,0) > 0.0) {
-      dPdx = (m_R(i+1,j) - m_R(i,j)) / m_dx;
+      dPdx = ((*P)(i+1,j) - (*P)(i,j)) / m_dx;
       dbdx = ((*bed)(i+1,j) - (*bed)(i,j)) / m_dx;
       result(i,j,0) = - m_Kstag(i,j,0) * (dPdx + rg * dbdx);
     } else {
@@ -575,7 +644,7 @@ void Routing::velocity_staggered(IceModelVec2Stag &result) {
     }
 
     if (m_Wstag(i,j,1) > 0.0) {
-      dPdy = (m_R(i,j+1) - m_R(i,j)) / m_dy;
+      dPdy = ((*P)(i,j+1) - (*P)(i,j)) / m_dy;
       dbdy = ((*bed)(i,j+1) - (*bed)(i,j)) / m_dy;
       result(i,j,1) = - m_Kstag(i,j,1) * (dPdy + rg * dbdy);
     } else {
@@ -601,15 +670,15 @@ The field W must have valid ghost values, but V does not need them.
 
 FIXME:  This could be re-implemented using the Koren (1993) flux-limiter.
  */
-void Routing::advective_fluxes(IceModelVec2Stag &result) {
+void Routing::advective_fluxes(IceModelVec2Stag &result, unsigned int width) {
   IceModelVec::AccessList list;
   list.add(m_W);
   list.add(m_V);
   list.add(result);
 
-  assert(m_W.get_stencil_width() >= 1);
+  assert(m_W.get_stencil_width() >= width + 1);
 
-  for (Points p(*m_grid); p; p.next()) {
+  for (PointsWithGhosts p(*m_grid, width); p; p.next()) {
     const int i = p.i(), j = p.j();
 
     result(i,j,0) = (m_V(i,j,0) >= 0.0) ? m_V(i,j,0) * m_W(i,j) :  m_V(i,j,0) * m_W(i+1,j);
@@ -655,8 +724,11 @@ duplication" because the code here: (1) computes `Wtilnew` instead of updating
 hydrology::Routing model; (3) does not check mask because the boundary_mass_changes()
 call addresses that.  Otherwise this is the same physical model with the
 same configurable parameters.
+
+If `width` is positive, Wtilnew is computed at `width` ghost points as
+well; this requires valid ghosts of Wtil and total_input.
  */
-void Routing::raw_update_Wtil(double hdt) {
+void Routing::raw_update_Wtil(double hdt, unsigned int width) {
   const double tillwat_max = m_config->get_double("hydrology_tillwat_max"),
                C           = m_config->get_double("hydrology_tillwat_decay_rate");
 
@@ -665,7 +737,7 @@ void Routing::raw_update_Wtil(double hdt) {
   list.add(m_Wtilnew);
   list.add(m_total_input);
 
-  for (Points p(*m_grid); p; p.next()) {
+  for (PointsWithGhosts p(*m_grid, width); p; p.next()) {
     const int i = p.i(), j = p.j();
 
     m_Wtilnew(i,j) = m_Wtil(i,j) + hdt * (m_total_input(i,j) - C);
@@ -675,13 +747,16 @@ void Routing::raw_update_Wtil(double hdt) {
 
 
 //! The computation of Wnew, called by update().
-void Routing::raw_update_W(double hdt) {
-  const double
-    wux  = 1.0 / (m_dx * m_dx),
-    wuy  = 1.0 / (m_dy * m_dy),
-    rg   = m_config->get_double("standard_gravity") * m_config->get_double("fresh_water_density");
-  double divadflux, diffW;
+/*!
+If `width` is positive, Wnew is computed at `width` ghost points as
+well; this requires valid values of all inputs at `width` ghost
+points and of staggered fields and W at `width + 1` ghost points.
 
+If `width` is zero, the update of ghosts of Qstag may be in progress
+(see update()). Ghosts of Qstag are not needed in the interior of the
+patch, so we finish the update only before processing the rim.
+ */
+void Routing::raw_update_W(double hdt, unsigned int width) {
   IceModelVec::AccessList list;
   list.add(m_W);
   list.add(m_Wtil);
@@ -692,7 +767,25 @@ void Routing::raw_update_W(double hdt) {
   list.add(m_total_input);
   list.add(m_Wnew);
 
-  for (Points p(*m_grid); p; p.next()) {
+  if (width == 0) {
+    raw_update_W(InteriorPoints(*m_grid, 1), hdt);
+    m_Qstag.update_ghosts_end();
+    raw_update_W(RimPoints(*m_grid, 1), hdt);
+  } else {
+    raw_update_W(PointsWithGhosts(*m_grid, width), hdt);
+  }
+}
+
+//! Compute Wnew at points visited by `p`. Fields have to be accessible.
+template <class Iterator>
+void Routing::raw_update_W(Iterator p, double hdt) {
+  const double
+    wux  = 1.0 / (m_dx * m_dx),
+    wuy  = 1.0 / (m_dy * m_dy),
+    rg   = m_config->get_double("standard_gravity") * m_config->get_double("fresh_water_density");
+  double divadflux, diffW;
+
+  for (; p; p.next()) {
     const int i = p.i(), j = p.j();
 
     divadflux =   (m_Qstag(i,j,0) - m_Qstag(i-1,j  ,0)) / m_dx
@@ -709,6 +802,33 @@ void Routing::raw_update_W(double hdt) {
 }
 
 
+//! Prepare fields with wide stencils for sub-stepping without ghost updates.
+/*!
+Copies the mask and the bed elevation, computes the overburden pressure
+`Pover` and (if needed) \f$R = P + \rho_w g b\f$, all including
+`m_wide_stencil_width` ghost points. These fields do not change during
+an update() call, so this costs one ghost update per field per call.
+ */
+void Routing::update_wide_fields() {
+  const double
+    rg   = m_config->get_double("standard_gravity") * m_config->get_double("fresh_water_density"),
+    beta = m_config->get_double("hydrology_gradient_power_in_flux");
+
+  m_mask_wide.copy_from(*m_grid->variables().get_2d_mask("mask"));
+  m_bed_wide.copy_from(*m_grid->variables().get_2d_scalar("bedrock_altitude"));
+
+  // this is what Routing::subglacial_water_pressure() computes
+  overburden_pressure(m_Pover);
+
+  if (beta != 2.0) {
+    m_R.copy_from(m_Pover);
+    m_R.add(rg, m_bed_wide); // R  <-- P + rhow g b
+  }
+
+  m_Wtil.update_ghosts();
+}
+
+
 //! Update the model state variables W and Wtil by applying the subglacial hydrology model equations.
 /*!
 Runs the hydrology model from time icet to time icet + icedt.  Here [icet,icedt]
@@ -717,6 +837,13 @@ own shorter time steps, perhaps hours to weeks.
 
 To update W = `bwat` we call raw_update_W(), and to update Wtil = `tillwat` we
 call raw_update_Wtil().
+
+If `hydrology_routing_substeps_per_ghost_update` is N > 1, W and related
+fields have N + 1 ghosts and we take N sub-steps per update of ghosts of W.
+Each sub-step re-computes staggered fields and W in ghost points (instead of
+getting them from neighbors), so the region where W is valid shrinks. Wtil
+evolves point-wise and so it is computed in all ghost points. Results do
+not depend on N.
  */
 void Routing::update_impl(double icet, double icedt) {
 
@@ -738,6 +865,14 @@ void Routing::update_impl(double icet, double icedt) {
   // make sure W has valid ghosts before starting hydrology steps
   m_W.update_ghosts();
 
+  const bool wide = m_wide_stencil_width > 0;
+  // number of ghosts of W which are up to date
+  unsigned int W_valid = m_wide_stencil_width;
+
+  if (wide) {
+    update_wide_fields();
+  }
+
   const IceModelVec2Int *mask = m_grid->variables().get_2d_mask("mask");
   MaskQuery M(*mask);
 
@@ -755,45 +890,72 @@ void Routing::update_impl(double icet, double icedt) {
     check_Wtil_bounds();
 #endif
 
-    water_thickness_staggered(m_Wstag);
-    m_Wstag.update_ghosts();
+    if (wide and W_valid == 0) {
+      m_W.update_ghosts();
+      W_valid = m_wide_stencil_width;
+    }
+
+    // numbers of ghost points where staggered fields and Wnew are computed
+    // (zero unless several sub-steps are taken per ghost update)
+    const unsigned int
+      stag_width = wide ? std::min(W_valid, m_wide_stencil_width - 1) : 0,
+      W_width    = wide ? stag_width - 1 : 0,
+      Wtil_width = wide ? m_wide_stencil_width : 0;
 
-    conductivity_staggered(m_Kstag,maxKW);
-    m_Kstag.update_ghosts();
+    water_thickness_staggered(m_Wstag, stag_width);
+    if (not wide) {
+      m_Wstag.update_ghosts();
+    }
+
+    conductivity_staggered(m_Kstag, maxKW, stag_width);
+    if (not wide) {
+      m_Kstag.update_ghosts();
+    }
 
-    velocity_staggered(m_V);
+    velocity_staggered(m_V, stag_width);
 
     // to get Qstag, W needs valid ghosts
-    advective_fluxes(m_Qstag);
-    m_Qstag.update_ghosts();
+    advective_fluxes(m_Qstag, stag_width);
+    if (not wide) {
+      // finished in raw_update_W(); nothing in between uses Qstag
+      m_Qstag.update_ghosts_begin();
+    }
 
     adaptive_for_W_evolution(ht, m_t+m_dt, maxKW,
                              hdt, maxV, maxD, dtCFL, dtDIFFW);
 
     if ((m_inputtobed != NULL) || (hydrocount==1)) {
       get_input_rate(ht,hdt,m_total_input);
+      if (wide) {
+        m_total_input.update_ghosts();
+      }
     }
 
     // update Wtilnew from Wtil
-    raw_update_Wtil(hdt);
+    raw_update_Wtil(hdt, Wtil_width);
     boundary_mass_changes(m_Wtilnew, delta_icefree, delta_ocean,
-                          delta_neggain, delta_nullstrip);
+                          delta_neggain, delta_nullstrip, Wtil_width);
     icefreelost  += delta_icefree;
     oceanlost    += delta_ocean;
     negativegain += delta_neggain;
     nullstriplost+= delta_nullstrip;
 
     // update Wnew from W, Wtil, Wtilnew, Wstag, Qstag, total_input
-    raw_update_W(hdt);
+    raw_update_W(hdt, W_width);
     boundary_mass_changes(m_Wnew, delta_icefree, delta_ocean,
-                          delta_neggain, delta_nullstrip);
+                          delta_neggain, delta_nullstrip, W_width);
     icefreelost  += delta_icefree;
     oceanlost    += delta_ocean;
     negativegain += delta_neggain;
     nullstriplost+= delta_nullstrip;
 
     // transfer new into old
-    m_Wnew.update_ghosts(m_W);
+    if (wide) {
+      m_W.copy_from(m_Wnew);    // copies ghosts; no communication
+      W_valid = W_width;
+    } else {
+      m_Wnew.update_ghosts(m_W);
+    }
     m_Wtil.copy_from(m_Wtilnew);
 
     ht += hdt;
@@ -289,7 +289,11 @@ void IceModel::write_variables(const PIO &nc, const std::set<std::string> &vars_
     if (diag == NULL) {
       ++i;
     } else {
-      IceModelVec::Ptr v_diagnostic = diag->compute();
+      IceModelVec::Ptr v_diagnostic;
+      {
+        MemoryScope scope(m_ctx->profiling(), "diagnostics");
+        v_diagnostic = diag->compute();
+      }
 
       v_diagnostic->write_in_glaciological_units = true;
       v_diagnostic->write(nc);
@@ -25,6 +25,7 @@
 #include "base/util/IceGrid.hh"
 #include "base/util/Mask.hh"
 #include "base/util/PISMConfigInterface.hh"
+#include "base/util/Profiling.hh"
 #include "base/util/error_handling.hh"
 #include "base/util/pism_options.hh"
 #include "coupler/PISMOcean.hh"
@@ -279,26 +280,39 @@ void IceModel::enthalpyAndDrainageStep(unsigned int *vertSacrCount,
 
   MaskQuery mask(vMask);
 
+  const double thickness_threshold = m_config->get_double("energy_advection_ice_thickness_threshold");
+
+  // Time spent in the column loop (not including the reduction in
+  // loop.check()) measures the work done by this processor; see
+  // IceModel::compute_cell_cost().
+  const Profiling &profiling = m_ctx->profiling();
+  profiling.begin("enth columns");
+
   ParallelSection loop(m_grid->com);
   try {
     for (Points pt(*m_grid); pt; pt.next()) {
       const int i = pt.i(), j = pt.j();
 
-      // ignore advection and strain heating in ice if isMarginal
-      const double thickness_threshold = m_config->get_double("energy_advection_ice_thickness_threshold");
-      const bool isMarginal = checkThinNeigh(ice_thickness, i, j, thickness_threshold);
+      // Columns with no ice at all (most of the ice-free area) do not
+      // need the column system: ks is zero there.
+      unsigned int ks = 0;
+      if (ice_thickness(i, j) > 0.0) {
+        // ignore advection and strain heating in ice if isMarginal
+        const bool isMarginal = checkThinNeigh(ice_thickness, i, j, thickness_threshold);
 
-      system.initThisColumn(i, j, isMarginal, ice_thickness(i, j));
+        system.initThisColumn(i, j, isMarginal, ice_thickness(i, j));
+        ks = system.ks();
+      }
 
       // enthalpy and pressures at top of ice
       const double
-        depth_ks = ice_thickness(i, j) - system.ks() * dz,
+        depth_ks = ice_thickness(i, j) - ks * dz,
         p_ks     = EC->pressure(depth_ks); // FIXME issue #15
 
       double Enth_ks = EC->enthalpy_permissive(ice_surface_temp(i, j), liqfrac_surface(i, j),
                                              p_ks);
 
-      const bool ice_free_column = (system.ks() == 0);
+      const bool ice_free_column = (ks == 0);
 
       // deal completely with columns with no ice; enthalpy and basal_melt_rate need setting
       if (ice_free_column) {
@@ -501,6 +515,7 @@ void IceModel::enthalpyAndDrainageStep(unsigned int *vertSacrCount,
   } catch (...) {
     loop.failed();
   }
+  profiling.end("enth columns");
   loop.check();
 
 
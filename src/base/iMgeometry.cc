@@ -65,6 +65,10 @@ void IceModel::updateSurfaceElevationAndMask() {
     // accordingly
     update_surface_elevation(bed_topography, ice_thickness, ice_surface_elevation);
   }
+
+  m_active_cells.update(vMask, ice_thickness);
+
+  m_scalar_stats_valid = 0;
 }
 
 /**
@@ -94,10 +98,23 @@ void IceModel::update_mask(const IceModelVec2S &bed,
   assert(bed.get_stencil_width() >= result.get_stencil_width());
   assert(thickness.get_stencil_width() >= result.get_stencil_width());
 
+  bool changed = false;
   for (PointsWithGhosts p(*m_grid, GHOSTS); p; p.next()) {
     const int i = p.i(), j = p.j();
 
-    result(i, j) = gc.mask(bed(i, j), thickness(i, j));
+    const double value = gc.mask(bed(i, j), thickness(i, j));
+    changed = changed or (result(i, j) != value);
+    result(i, j) = value;
+  }
+
+  // Increment the state counter only if the mask changed (anywhere),
+  // so that code depending on it (such as calving::FrontIndex) can skip
+  // re-computation. The decision has to be the same on all processors,
+  // which costs one single-value reduction per call. (This is cheap
+  // compared to re-building cell lists and updating ghosts of the mask
+  // every time step.)
+  if (GlobalMax(m_grid->com, changed ? 1.0 : 0.0) > 0.0) {
+    result.inc_state_counter();
   }
 }
 
@@ -131,6 +148,7 @@ void IceModel::update_surface_elevation(const IceModelVec2S &bed,
   assert(bed.get_stencil_width() >= result.get_stencil_width());
   assert(thickness.get_stencil_width() >= result.get_stencil_width());
 
+  bool changed = false;
   ParallelSection loop(m_grid->com);
   try {
     for (PointsWithGhosts p(*m_grid, GHOSTS); p; p.next()) {
@@ -140,12 +158,20 @@ void IceModel::update_surface_elevation(const IceModelVec2S &bed,
       if (thickness(i, j) < 0) {
         throw RuntimeError::formatted("Thickness negative at point i=%d, j=%d", i, j);
       }
-      result(i, j) = gc.surface(bed(i, j), thickness(i, j));
+      const double value = gc.surface(bed(i, j), thickness(i, j));
+      changed = changed or (result(i, j) != value);
+      result(i, j) = value;
     }
   } catch (...) {
     loop.failed();
   }
-  loop.check();
+
+  // Increment the state counter only if the surface elevation changed
+  // (see update_mask()). The flag is combined with the error check, so
+  // this does not add a reduction.
+  if (loop.check(changed)) {
+    result.inc_state_counter();
+  }
 }
 
 //! \brief Adjust ice flow through interfaces of the cell i,j.
@@ -542,16 +568,26 @@ void IceModel::massContExplicitStep() {
 
   const IceModelVec2S &bed_topography = beddef->bed_elevation();
 
+  // the loop below skips cells in the open ocean (see ActiveCells), so
+  // we have to initialize the flux divergence there
+  if (compute_flux_divergence) {
+    flux_divergence.set(0.0);
+  }
+
+  // Inputs are added as const so that their ghosts stay current (see
+  // IceModelVec::update_ghosts()).
+  const IceModel &model = *this;
+
   IceModelVec::AccessList list;
-  list.add(cell_area);
-  list.add(ice_thickness);
-  list.add(ice_surface_elevation);
+  list.add(model.cell_area);
+  list.add(model.ice_thickness);
+  list.add(model.ice_surface_elevation);
   list.add(bed_topography);
-  list.add(basal_melt_rate);
+  list.add(model.basal_melt_rate);
   list.add(Qdiff);
   list.add(vel_advective);
-  list.add(climatic_mass_balance);
-  list.add(vMask);
+  list.add(model.climatic_mass_balance);
+  list.add(model.vMask);
   list.add(vHnew);
 
   // related to PIK part_grid mechanism; see Albrecht et al 2011
@@ -569,8 +605,8 @@ void IceModel::massContExplicitStep() {
   }
   const bool dirichlet_bc = m_config->get_boolean("ssa_dirichlet_bc");
   if (dirichlet_bc) {
-    list.add(vBCMask);
-    list.add(vBCvel);
+    list.add(model.vBCMask);
+    list.add(model.vBCvel);
   }
 
   if (compute_cumulative_climatic_mass_balance) {
@@ -595,9 +631,13 @@ void IceModel::massContExplicitStep() {
 
   MaskQuery mask(vMask);
 
+  // Ice-free ocean cells with no ice in them and around them do not
+  // change: there is no flux through their boundaries and both the
+  // SMB and the basal melt rate are ignored there. Skipping these
+  // cells does not change any of the sums below.
   ParallelSection loop(m_grid->com);
   try {
-    for (Points p(*m_grid); p; p.next()) {
+    for (CellListPoints p(m_active_cells); p; p.next()) {
       const int i = p.i(), j = p.j();
 
       // These constants are used to convert ice equivalent
@@ -918,10 +958,12 @@ void IceModel::update_floatation_mask() {
 
   const IceModelVec2S &bed_topography = beddef->bed_elevation();
 
+  const IceModel &model = *this;
+
   IceModelVec::AccessList list;
-  list.add(ice_thickness);
+  list.add(model.ice_thickness);
   list.add(bed_topography);
-  list.add(vMask);
+  list.add(model.vMask);
   list.add(gl_mask);
   list.add(gl_mask_x);
   list.add(gl_mask_y);
@@ -56,6 +56,7 @@
 #include "varcEnthalpyConverter.hh"
 #include "base/util/PISMVars.hh"
 #include "base/util/io/io_helpers.hh"
+#include "base/util/Profiling.hh"
 
 namespace pism {
 
@@ -95,6 +96,7 @@ void IceModel::time_setup() {
   than once (memory allocation is one example).
  */
 void IceModel::model_state_setup() {
+  const Profiling &profiling = m_ctx->profiling();
 
   reset_counters();
 
@@ -119,13 +121,19 @@ void IceModel::model_state_setup() {
   // after the regrid(0) call but before other init() calls that need
   // bed elevation and uplift.
   if (beddef) {
-    beddef->init();
+    {
+      MemoryScope scope(profiling, "bed deformation");
+      beddef->init();
+    }
     m_grid->variables().add(beddef->bed_elevation());
     m_grid->variables().add(beddef->uplift());
   }
 
   if (stress_balance) {
-    stress_balance->init();
+    {
+      MemoryScope scope(profiling, "stress balance");
+      stress_balance->init();
+    }
 
     if (m_config->get_boolean("include_bmr_in_continuity")) {
       stress_balance->set_basal_melt_rate(basal_melt_rate);
@@ -150,12 +158,14 @@ void IceModel::model_state_setup() {
   }
 
   if (subglacial_hydrology) {
+    MemoryScope scope(profiling, "basal hydrology");
     subglacial_hydrology->init();
   }
 
   // basal_yield_stress_model->init() needs bwat so this must happen
   // after subglacial_hydrology->init()
   if (basal_yield_stress_model) {
+    MemoryScope scope(profiling, "basal yield stress");
     basal_yield_stress_model->init();
   }
 
@@ -440,6 +450,7 @@ void IceModel::allocate_basal_yield_stress() {
   setting up the coupling or filling model-state variables.
  */
 void IceModel::allocate_submodels() {
+  const Profiling &profiling = m_ctx->profiling();
 
   // FIXME: someday we will have an "energy balance" sub-model...
   if (m_config->get_boolean("do_energy") == true) {
@@ -452,21 +463,42 @@ void IceModel::allocate_submodels() {
     }
   }
 
-  allocate_iceberg_remover();
+  {
+    MemoryScope scope(profiling, "calving");
+    allocate_iceberg_remover();
+  }
 
-  allocate_stressbalance();
+  {
+    MemoryScope scope(profiling, "stress balance");
+    allocate_stressbalance();
+  }
 
   // this has to happen *after* allocate_stressbalance()
-  allocate_subglacial_hydrology();
+  {
+    MemoryScope scope(profiling, "basal hydrology");
+    allocate_subglacial_hydrology();
+  }
 
   // this has to happen *after* allocate_subglacial_hydrology()
-  allocate_basal_yield_stress();
+  {
+    MemoryScope scope(profiling, "basal yield stress");
+    allocate_basal_yield_stress();
+  }
 
-  allocate_bedrock_thermal_unit();
+  {
+    MemoryScope scope(profiling, "bedrock thermal unit");
+    allocate_bedrock_thermal_unit();
+  }
 
-  allocate_bed_deformation();
+  {
+    MemoryScope scope(profiling, "bed deformation");
+    allocate_bed_deformation();
+  }
 
-  allocate_couplers();
+  {
+    MemoryScope scope(profiling, "surface and ocean");
+    allocate_couplers();
+  }
 }
 
 
@@ -501,9 +533,13 @@ void IceModel::allocate_couplers() {
 //! Initializes atmosphere and ocean couplers.
 void IceModel::init_couplers() {
 
+  const Profiling &profiling = m_ctx->profiling();
+
   m_log->message(3,
              "Initializing boundary models...\n");
 
+  MemoryScope scope(profiling, "surface and ocean");
+
   assert(surface != NULL);
   surface->init();
 
@@ -140,6 +140,11 @@ std::set<std::string> IceModel::set_output_size(const std::string &keyword) {
     result.insert("discharge_flux_cumulative");
   }
 
+  // measured costs are used to choose the domain decomposition when re-starting
+  if (m_config->get_boolean("grid_ice_aware_decomposition")) {
+    result.insert("cell_cost");
+  }
+
   if (keyword == "medium") {
     // add all the variables listed in the config file ("medium" size):
     std::string tmp = m_config->get_string("output_medium");
@@ -19,6 +19,8 @@
 #include <cstring>
 #include <petscsys.h>
 #include <cstdlib>
+#include <sstream>
+#include <algorithm>
 
 #include "iceModel.hh"
 
@@ -27,6 +29,7 @@
 #include "base/util/Mask.hh"
 #include "base/util/PISMConfigInterface.hh"
 #include "base/util/PISMTime.hh"
+#include "base/util/Profiling.hh"
 #include "base/util/error_handling.hh"
 #include "coupler/PISMOcean.hh"
 #include "earth/PISMBedDef.hh"
@@ -37,47 +40,13 @@ namespace pism {
 /*!
   Computes fraction of the base which is melted.
 
-  Communication occurs here.
+  Communication may occur here (see scalar_stats()).
 
   FIXME: energyStats should use cell_area(i,j).
  */
 double IceModel::compute_temperate_base_fraction(double ice_area) {
 
-  EnthalpyConverter::Ptr EC = m_ctx->enthalpy_converter();
-
-  double result = 0.0, meltarea = 0.0;
-  const double a = m_grid->dx() * m_grid->dy() * 1e-3 * 1e-3; // area unit (km^2)
-
-  IceModelVec2S &Enthbase = vWork2d[0];
-  // use Enth3 to get stats
-  Enth3.getHorSlice(Enthbase, 0.0);  // z=0 slice
-
-  MaskQuery mask(vMask);
-
-  IceModelVec::AccessList list;
-  list.add(vMask);
-  list.add(ice_thickness);
-  list.add(Enthbase);
-  ParallelSection loop(m_grid->com);
-  try {
-    for (Points p(*m_grid); p; p.next()) {
-      const int i = p.i(), j = p.j();
-
-      if (mask.icy(i, j)) {
-        // accumulate area of base which is at melt point
-        if (EC->is_temperate(Enthbase(i,j), EC->pressure(ice_thickness(i,j)))) { // FIXME issue #15
-          meltarea += a;
-        }
-      }
-    }
-  } catch (...) {
-    loop.failed();
-  }
-  loop.check();
-
-
-  // communication
-  result = GlobalSum(m_grid->com, meltarea);
+  double result = scalar_stats(STATS_BASE).temperate_base_area_km2;
 
   // normalize fraction correctly
   if (ice_area > 0.0) {
@@ -153,6 +122,126 @@ double IceModel::compute_original_ice_fraction(double ice_volume) {
 }
 
 
+//! Estimate the computational cost of each grid cell, in seconds.
+/*!
+ * Uses the time this processor spent in the column-by-column energy
+ * update so far ("enth columns" and "temp columns" profiling regions).
+ * This loop involves no communication, so (unlike the time spent in
+ * most other parts of a time step) it does not include time spent
+ * waiting for other processors. It is distributed among cells owned by
+ * this processor in proportion to the ice-aware weights (an icy cell
+ * gets `grid_ice_column_cost` times the share of an ice-free one).
+ *
+ * Written to output files if `grid_ice_aware_decomposition` is set, so
+ * that a run re-started from them can use measured costs to choose the
+ * domain decomposition (see GridParameters::ownership_ranges_from_file()).
+ *
+ * If there were no energy steps yet, the result contains the weights
+ * themselves, so that a re-started run gets the same decomposition as
+ * one using the ice thickness.
+ */
+void IceModel::compute_cell_cost(IceModelVec2S &result) {
+  const Profiling &profiling = m_ctx->profiling();
+
+  const double
+    ice_cost = m_config->get_double("grid_ice_column_cost"),
+    time     = profiling.time("enth columns") + profiling.time("temp columns");
+
+  MaskQuery mask(vMask);
+
+  IceModelVec::AccessList list;
+  list.add(vMask);
+  list.add(result);
+
+  double total_weight = 0.0;
+  for (Points p(*m_grid); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    result(i, j) = mask.icy(i, j) ? ice_cost : 1.0;
+    total_weight += result(i, j);
+  }
+
+  if (time <= 0.0) {
+    return;
+  }
+
+  const double scale = time / total_weight;
+  for (Points p(*m_grid); p; p.next()) {
+    result(p.i(), p.j()) *= scale;
+  }
+}
+
+//! Report load imbalance and suggest a better domain decomposition.
+/*!
+ * Uses the time each processor spent in the column-by-column energy
+ * update as the measure of work (see compute_cell_cost()).
+ *
+ * The grid cannot be re-partitioned during a run. If the busiest
+ * processor did more than `grid_imbalance_threshold` times the average
+ * amount of work, we print ownership ranges (`-procs_x` and `-procs_y`)
+ * balancing the measured costs for the next run. These are the ranges
+ * `-ice_aware_decomposition` would choose using `cell_cost`.
+ *
+ * Called once, at the end of a run. Disabled by setting
+ * `grid_imbalance_threshold` (option `-imbalance_threshold`) to zero.
+ */
+void IceModel::check_load_balance() {
+  const double threshold = m_config->get_double("grid_imbalance_threshold");
+
+  if (threshold <= 0.0 or m_grid->size() == 1) {
+    return;
+  }
+
+  const Profiling &profiling = m_ctx->profiling();
+
+  const double
+    work      = profiling.time("enth columns") + profiling.time("temp columns"),
+    max_work  = GlobalMax(m_grid->com, work),
+    mean_work = GlobalSum(m_grid->com, work) / m_grid->size();
+
+  if (mean_work <= 0.0 or max_work <= threshold * mean_work) {
+    return;
+  }
+
+  // sums of measured costs over columns and rows of the grid
+  const unsigned int Mx = m_grid->Mx(), My = m_grid->My();
+  std::vector<double> x(Mx, 0.0), y(My, 0.0), x_sum(Mx, 0.0), y_sum(My, 0.0);
+  {
+    IceModelVec2S &cost = vWork2d[0];
+    compute_cell_cost(cost);
+
+    IceModelVec::AccessList list(cost);
+    for (Points p(*m_grid); p; p.next()) {
+      const int i = p.i(), j = p.j();
+      x[i] += cost(i, j);
+      y[j] += cost(i, j);
+    }
+  }
+  GlobalSum(m_grid->com, &x[0], &x_sum[0], Mx);
+  GlobalSum(m_grid->com, &y[0], &y_sum[0], My);
+
+  const unsigned int min_width = std::max(2, (int)m_config->get_double("grid_max_stencil_width"));
+
+  const std::vector<unsigned int>
+    procs_x = weighted_ownership_ranges(x_sum, m_grid->Nx(), min_width),
+    procs_y = weighted_ownership_ranges(y_sum, m_grid->Ny(), min_width);
+
+  std::ostringstream ranges;
+  ranges << "-procs_x ";
+  for (unsigned int k = 0; k < procs_x.size(); ++k) {
+    ranges << (k > 0 ? "," : "") << procs_x[k];
+  }
+  ranges << " -procs_y ";
+  for (unsigned int k = 0; k < procs_y.size(); ++k) {
+    ranges << (k > 0 ? "," : "") << procs_y[k];
+  }
+
+  m_log->message(2,
+                 "PISM WARNING: the busiest processor spent %.1f times the average time in the energy update.\n"
+                 "  Ownership ranges balancing measured costs: %s\n",
+                 max_work / mean_work, ranges.str().c_str());
+}
+
 void IceModel::summary(bool tempAndAge) {
 
   // report CFL violations
@@ -173,11 +262,16 @@ void IceModel::summary(bool tempAndAge) {
   // get maximum diffusivity
   double max_diffusivity = stress_balance->max_diffusivity();
   // get volumes in m^3 and areas in m^2
+  const bool report_meltfrac = tempAndAge or getVerbosityLevel() >= 3;
+
+  // compute all the quantities we need in one pass
+  scalar_stats(report_meltfrac ? STATS_GEOMETRY | STATS_BASE : STATS_GEOMETRY);
+
   double ice_volume = compute_ice_volume();
   double ice_area = compute_ice_area();
 
   double meltfrac = 0.0;
-  if (tempAndAge or getVerbosityLevel() >= 3) {
+  if (report_meltfrac) {
     meltfrac = compute_temperate_base_fraction(ice_area);
   }
 
@@ -305,154 +399,159 @@ void IceModel::summaryPrintLine(bool printPrototype,  bool tempAndAge,
 }
 
 
-//! Computes the ice volume, in m^3.
-double IceModel::compute_ice_volume() {
-  IceModelVec::AccessList list;
-  list.add(cell_area);
-
-  double volume = 0.0;
+IceModel::ScalarStats::ScalarStats() {
+  ice_volume              = 0.0;
+  sealevel_volume         = 0.0;
+  ice_area                = 0.0;
+  ice_area_grounded       = 0.0;
+  ice_area_floating       = 0.0;
+  ice_area_temperate      = 0.0;
+  ice_area_cold           = 0.0;
+  temperate_base_area_km2 = 0.0;
+  ice_volume_temperate    = 0.0;
+  ice_volume_cold         = 0.0;
+  ice_enthalpy            = 0.0;
+}
 
-  {
-    list.add(ice_thickness);
-    for (Points p(*m_grid); p; p.next()) {
-      const int i = p.i(), j = p.j();
+//! Get scalar diagnostic quantities, re-computing `groups` if necessary.
+/*!
+ * Results are cached until the end of the current time step (or the
+ * next geometry update), so the cost of reporting does not depend on
+ * the number of scalar time-series requested. Groups that are missing
+ * from the cache are computed together, in one pass over the grid and
+ * with one reduction.
+ *
+ * @param[in] groups a combination of ScalarStatsGroup flags
+ */
+const IceModel::ScalarStats& IceModel::scalar_stats(unsigned int groups) {
+  const unsigned int missing = groups & ~m_scalar_stats_valid;
 
-      // count all ice, including cells which have so little they
-      // are considered "ice-free"
-      if (ice_thickness(i,j) > 0.0) {
-        volume += ice_thickness(i,j) * cell_area(i,j);
-      }
-    }
+  if (missing != 0) {
+    compute_scalar_stats(missing, m_scalar_stats);
+    m_scalar_stats_valid |= missing;
   }
 
-  // Add the volume of the ice in Href:
-  if (m_config->get_boolean("part_grid")) {
-    list.add(vHref);
-    for (Points p(*m_grid); p; p.next()) {
-      const int i = p.i(), j = p.j();
+  return m_scalar_stats;
+}
 
-      volume += vHref(i,j) * cell_area(i,j);
-    }
-  }
+//! Compute scalar diagnostic quantities in `groups`, leaving other fields of `result` alone.
+void IceModel::compute_scalar_stats(unsigned int groups, ScalarStats &result) {
+  const bool
+    geometry  = groups & STATS_GEOMETRY,
+    base      = groups & STATS_BASE,
+    energy    = groups & STATS_ENERGY,
+    part_grid = m_config->get_boolean("part_grid");
 
-  return GlobalSum(m_grid->com, volume);
-}
+  EnthalpyConverter::Ptr EC = m_ctx->enthalpy_converter();
 
-//! Computes the ice volume, which is relevant for sea-level rise in m^3 in SEA-WATER EQUIVALENT.
-double IceModel::compute_sealevel_volume() {
-  double volume = 0.0;
-  MaskQuery mask(vMask);
-  double ocean_rho = m_config->get_double("sea_water_density");
-  double ice_rho = m_config->get_double("ice_density");
+  const double
+    ocean_rho = m_config->get_double("sea_water_density"),
+    ice_rho   = m_config->get_double("ice_density"),
+    a_km2     = m_grid->dx() * m_grid->dy() * 1e-3 * 1e-3; // area unit (km^2)
 
-  assert (ocean != NULL);
-  double sea_level = ocean->sea_level_elevation();
+  assert(ocean != NULL);
+  const double sea_level = ocean->sea_level_elevation();
 
   assert(beddef != NULL);
   const IceModelVec2S &bed_topography = beddef->bed_elevation();
 
-  IceModelVec::AccessList list;
-  list.add(vMask);
-  list.add(ice_thickness);
-  list.add(bed_topography);
-  list.add(cell_area);
-  for (Points p(*m_grid); p; p.next()) {
-    const int i = p.i(), j = p.j();
-
-    if (mask.grounded(i,j)) {
-      // count all ice, including cells which have so little they
-      // are considered "ice-free"
-      if (ice_thickness(i,j) > 0) {
-        if (bed_topography(i, j) > sea_level) {
-          volume += ice_thickness(i,j) * cell_area(i,j) * ice_rho/ocean_rho ;
-        } else {
-          volume += ice_thickness(i,j) * cell_area(i,j) * ice_rho/ocean_rho - cell_area(i,j) * (sea_level - bed_topography(i, j));
-        }
-      }
-    }
+  // local sums, in the order of the fields of ScalarStats
+  enum {VOLUME = 0, SL_VOLUME, AREA, AREA_GROUNDED, AREA_FLOATING,
+        AREA_TEMPERATE, AREA_COLD, BASE_AREA_KM2,
+        VOLUME_TEMPERATE, VOLUME_COLD, ENTHALPY, N_STATS};
+  double local[N_STATS], global[N_STATS];
+  for (int k = 0; k < N_STATS; ++k) {
+    local[k] = 0.0;
   }
-  const double ocean_area = 3.61e14; //in square meters
-  volume /= ocean_area;
 
-  return GlobalSum(m_grid->com, volume);
-}
-
-//! Computes the temperate ice volume, in m^3.
-double  IceModel::compute_ice_volume_temperate() {
-
-  EnthalpyConverter::Ptr EC = m_ctx->enthalpy_converter();
-
-  double volume = 0.0;
+  MaskQuery mask(vMask);
 
   IceModelVec::AccessList list;
+  list.add(vMask);
   list.add(ice_thickness);
-  list.add(Enth3);
   list.add(cell_area);
+  if (geometry) {
+    list.add(bed_topography);
+    if (part_grid) {
+      list.add(vHref);
+    }
+  }
+  if (base or energy) {
+    list.add(Enth3);
+  }
 
   ParallelSection loop(m_grid->com);
   try {
     for (Points p(*m_grid); p; p.next()) {
       const int i = p.i(), j = p.j();
 
-      // count all ice, including cells which have so little they are
-      // considered "ice-free"
-      if (ice_thickness(i,j) > 0) {
-        const int ks = m_grid->kBelowHeight(ice_thickness(i,j));
-        const double *Enth = Enth3.get_column(i,j);
-        const double A = cell_area(i, j);
-
-        for (int k = 0; k < ks; ++k) {
-          if (EC->is_temperate(Enth[k],EC->pressure(ice_thickness(i,j)))) { // FIXME issue #15
-            volume += (m_grid->z(k + 1) - m_grid->z(k)) * A;
+      const double
+        H = ice_thickness(i, j),
+        A = cell_area(i, j);
+
+      if (geometry) {
+        // count all ice, including cells which have so little they
+        // are considered "ice-free"
+        if (H > 0.0) {
+          local[VOLUME] += H * A;
+
+          if (mask.grounded(i, j)) {
+            if (bed_topography(i, j) > sea_level) {
+              local[SL_VOLUME] += H * A * ice_rho / ocean_rho;
+            } else {
+              local[SL_VOLUME] += H * A * ice_rho / ocean_rho - A * (sea_level - bed_topography(i, j));
+            }
           }
         }
 
-        if (EC->is_temperate(Enth[ks],EC->pressure(ice_thickness(i,j)))) { // FIXME issue #15
-          volume += (ice_thickness(i,j) - m_grid->z(ks)) * A;
+        // add the volume of the ice in Href
+        if (part_grid) {
+          local[VOLUME] += vHref(i, j) * A;
         }
-      }
-    }
-  } catch (...) {
-    loop.failed();
-  }
-  loop.check();
 
+        if (mask.icy(i, j)) {
+          local[AREA] += A;
+        }
 
-  return GlobalSum(m_grid->com, volume);
-}
-
-//! Computes the cold ice volume, in m^3.
-double IceModel::compute_ice_volume_cold() {
-
-  EnthalpyConverter::Ptr EC = m_ctx->enthalpy_converter();
-
-  double volume = 0.0;
+        if (mask.grounded_ice(i, j)) {
+          local[AREA_GROUNDED] += A;
+        }
 
-  IceModelVec::AccessList list;
-  list.add(ice_thickness);
-  list.add(Enth3);
-  list.add(cell_area);
+        if (mask.floating_ice(i, j)) {
+          local[AREA_FLOATING] += A;
+        }
+      }
 
-  ParallelSection loop(m_grid->com);
-  try {
-    for (Points p(*m_grid); p; p.next()) {
-      const int i = p.i(), j = p.j();
+      if (base and mask.icy(i, j)) {
+        const double E_base = Enth3.get_column(i, j)[0];
 
-      // count all ice, including cells which have so little they
-      // are considered "ice-free"
-      if (ice_thickness(i,j) > 0) {
-        const int ks = m_grid->kBelowHeight(ice_thickness(i,j));
-        const double *Enth = Enth3.get_column(i,j);
-        const double A = cell_area(i, j);
+        if (EC->is_temperate(E_base, EC->pressure(H))) { // FIXME issue #15
+          local[AREA_TEMPERATE] += A;
+          local[BASE_AREA_KM2]  += a_km2;
+        } else {
+          local[AREA_COLD] += A;
+        }
+      }
 
-        for (int k=0; k<ks; ++k) {
-          if (not EC->is_temperate(Enth[k],EC->pressure(ice_thickness(i,j)))) { // FIXME issue #15
-            volume += (m_grid->z(k+1) - m_grid->z(k)) * A;
+      // count all ice, including cells which have so little they are
+      // considered "ice-free"
+      if (energy and H > 0.0) {
+        const int ks = m_grid->kBelowHeight(H);
+        const double
+          *Enth = Enth3.get_column(i, j),
+          P     = EC->pressure(H); // FIXME issue #15
+
+        for (int k = 0; k <= ks; ++k) {
+          // the top layer extends to the ice surface
+          const double dz = k < ks ? m_grid->z(k + 1) - m_grid->z(k) : H - m_grid->z(ks);
+
+          if (EC->is_temperate(Enth[k], P)) {
+            local[VOLUME_TEMPERATE] += dz * A;
+          } else {
+            local[VOLUME_COLD] += dz * A;
           }
-        }
 
-        if (not EC->is_temperate(Enth[ks],EC->pressure(ice_thickness(i,j)))) { // FIXME issue #15
-          volume += (ice_thickness(i,j) - m_grid->z(ks)) * A;
+          local[ENTHALPY] += Enth[k] * dz;
         }
       }
     }
@@ -461,141 +560,75 @@ double IceModel::compute_ice_volume_cold() {
   }
   loop.check();
 
+  GlobalSum(m_grid->com, local, global, N_STATS);
 
-  return GlobalSum(m_grid->com, volume);
-}
-
-//! Computes ice area, in m^2.
-double IceModel::compute_ice_area() {
-  double area = 0.0;
-
-  MaskQuery mask(vMask);
+  if (geometry) {
+    const double ocean_area = 3.61e14; //in square meters
 
-  IceModelVec::AccessList list;
-  list.add(vMask);
-  list.add(ice_thickness);
-  list.add(cell_area);
-  for (Points p(*m_grid); p; p.next()) {
-    const int i = p.i(), j = p.j();
+    result.ice_volume        = global[VOLUME];
+    result.sealevel_volume   = global[SL_VOLUME] / ocean_area;
+    result.ice_area          = global[AREA];
+    result.ice_area_grounded = global[AREA_GROUNDED];
+    result.ice_area_floating = global[AREA_FLOATING];
+  }
 
-    if (mask.icy(i, j)) {
-      area += cell_area(i,j);
-    }
+  if (base) {
+    result.ice_area_temperate      = global[AREA_TEMPERATE];
+    result.ice_area_cold           = global[AREA_COLD];
+    result.temperate_base_area_km2 = global[BASE_AREA_KM2];
   }
 
-  return GlobalSum(m_grid->com, area);
+  if (energy) {
+    result.ice_volume_temperate = global[VOLUME_TEMPERATE];
+    result.ice_volume_cold      = global[VOLUME_COLD];
+    // FIXME: use cell_area.
+    result.ice_enthalpy         = global[ENTHALPY] * ice_rho * (m_grid->dx() * m_grid->dy());
+  }
 }
 
-//! Computes area of basal ice which is temperate, in m^2.
-double IceModel::compute_ice_area_temperate() {
-
-  EnthalpyConverter::Ptr EC = m_ctx->enthalpy_converter();
-
-  double area = 0.0;
-  IceModelVec2S &Enthbase = vWork2d[0];
-
-  Enth3.getHorSlice(Enthbase, 0.0);  // z=0 slice
+//! Computes the ice volume, in m^3.
+double IceModel::compute_ice_volume() {
+  return scalar_stats(STATS_GEOMETRY).ice_volume;
+}
 
-  MaskQuery mask(vMask);
+//! Computes the ice volume, which is relevant for sea-level rise in m^3 in SEA-WATER EQUIVALENT.
+double IceModel::compute_sealevel_volume() {
+  return scalar_stats(STATS_GEOMETRY).sealevel_volume;
+}
 
-  IceModelVec::AccessList list;
-  list.add(vMask);
-  list.add(Enthbase);
-  list.add(ice_thickness);
-  list.add(cell_area);
-  ParallelSection loop(m_grid->com);
-  try {
-    for (Points p(*m_grid); p; p.next()) {
-      const int i = p.i(), j = p.j();
+//! Computes the temperate ice volume, in m^3.
+double  IceModel::compute_ice_volume_temperate() {
+  return scalar_stats(STATS_ENERGY).ice_volume_temperate;
+}
 
-      if (mask.icy(i, j) and
-          EC->is_temperate(Enthbase(i,j), EC->pressure(ice_thickness(i,j)))) { // FIXME issue #15
-        area += cell_area(i,j);
-      }
-    }
-  } catch (...) {
-    loop.failed();
-  }
-  loop.check();
+//! Computes the cold ice volume, in m^3.
+double IceModel::compute_ice_volume_cold() {
+  return scalar_stats(STATS_ENERGY).ice_volume_cold;
+}
 
+//! Computes ice area, in m^2.
+double IceModel::compute_ice_area() {
+  return scalar_stats(STATS_GEOMETRY).ice_area;
+}
 
-  return GlobalSum(m_grid->com, area);
+//! Computes area of basal ice which is temperate, in m^2.
+double IceModel::compute_ice_area_temperate() {
+  return scalar_stats(STATS_BASE).ice_area_temperate;
 }
 
 //! Computes area of basal ice which is cold, in m^2.
 double IceModel::compute_ice_area_cold() {
-
-  EnthalpyConverter::Ptr EC = m_ctx->enthalpy_converter();
-
-  double area = 0.0;
-  IceModelVec2S &Enthbase = vWork2d[0];
-
-  Enth3.getHorSlice(Enthbase, 0.0);  // z=0 slice
-
-  MaskQuery mask(vMask);
-
-  IceModelVec::AccessList list;
-  list.add(vMask);
-  list.add(Enthbase);
-  list.add(ice_thickness);
-  list.add(cell_area);
-  ParallelSection loop(m_grid->com);
-  try {
-    for (Points p(*m_grid); p; p.next()) {
-      const int i = p.i(), j = p.j();
-
-      if (mask.icy(i, j) and
-          EC->is_temperate(Enthbase(i,j), EC->pressure(ice_thickness(i,j))) == false) { // FIXME issue #15
-        area += cell_area(i,j);
-      }
-    }
-  } catch (...) {
-    loop.failed();
-  }
-  loop.check();
-
-
-  return GlobalSum(m_grid->com, area);
+  return scalar_stats(STATS_BASE).ice_area_cold;
 }
 
 //! Computes grounded ice area, in m^2.
 double IceModel::compute_ice_area_grounded() {
-  double area = 0.0;
-
-  MaskQuery mask(vMask);
-
-  IceModelVec::AccessList list;
-  list.add(vMask);
-  list.add(cell_area);
-  for (Points p(*m_grid); p; p.next()) {
-    const int i = p.i(), j = p.j();
-
-    if (mask.grounded_ice(i,j)) {
-      area += cell_area(i,j);
-    }
-  }
-
-  return GlobalSum(m_grid->com, area);
+  return scalar_stats(STATS_GEOMETRY).ice_area_grounded;
 }
 
 //! Computes floating ice area, in m^2.
 double IceModel::compute_ice_area_floating() {
-  double area = 0.0;
-
-  MaskQuery mask(vMask);
-
-  IceModelVec::AccessList list;
-  list.add(vMask);
-  list.add(cell_area);
-  for (Points p(*m_grid); p; p.next()) {
-    const int i = p.i(), j = p.j();
-
-    if (mask.floating_ice(i,j)) {
-      area += cell_area(i,j);
-    }
-  }
-
-  return GlobalSum(m_grid->com, area);
+  return scalar_stats(STATS_GEOMETRY).ice_area_floating;
 }
 
 
@@ -607,37 +640,7 @@ double IceModel::compute_ice_area_floating() {
   \f[ E_{\text{total}}(t) = \int_{\Omega(t)} E(t,x,y,z) \rho_i \,dx\,dy\,dz. \f]
 */
 double IceModel::compute_ice_enthalpy() {
-  double enthalpy_sum = 0.0;
-
-  IceModelVec::AccessList list;
-  list.add(ice_thickness);
-  list.add(Enth3);
-  ParallelSection loop(m_grid->com);
-  try {
-    for (Points p(*m_grid); p; p.next()) {
-      const int i = p.i(), j = p.j();
-
-      // count all ice, including cells which have so little they
-      // are considered "ice-free"
-      if (ice_thickness(i,j) > 0) {
-        const int ks = m_grid->kBelowHeight(ice_thickness(i,j));
-        const double *Enth = Enth3.get_column(i,j);
-
-        for (int k=0; k<ks; ++k) {
-          enthalpy_sum += Enth[k] * (m_grid->z(k+1) - m_grid->z(k));
-        }
-        enthalpy_sum += Enth[ks] * (ice_thickness(i,j) - m_grid->z(ks));
-      }
-    }
-  } catch (...) {
-    loop.failed();
-  }
-  loop.check();
-
-  // FIXME: use cell_area.
-  enthalpy_sum *= m_config->get_double("ice_density") * (m_grid->dx() * m_grid->dy());
-
-  return GlobalSum(m_grid->com, enthalpy_sum);
+  return scalar_stats(STATS_ENERGY).ice_enthalpy;
 }
 
 } // end of namespace pism
@@ -27,6 +27,7 @@
 #include "base/util/IceGrid.hh"
 #include "base/util/Mask.hh"
 #include "base/util/PISMConfigInterface.hh"
+#include "base/util/Profiling.hh"
 #include "base/util/error_handling.hh"
 #include "base/util/pism_options.hh"
 #include "coupler/PISMOcean.hh"
@@ -217,6 +218,10 @@ void IceModel::temperatureStep(unsigned int *vertSacrCount, unsigned int *bulgeC
 
   const double thickness_threshold = m_config->get_double("energy_advection_ice_thickness_threshold");
 
+  // measures the work done by this processor (see enthalpyAndDrainageStep())
+  const Profiling &profiling = m_ctx->profiling();
+  profiling.begin("temp columns");
+
   ParallelSection loop(m_grid->com);
   try {
     for (Points p(*m_grid); p; p.next()) {
@@ -348,6 +353,7 @@ void IceModel::temperatureStep(unsigned int *vertSacrCount, unsigned int *bulgeC
   } catch (...) {
     loop.failed();
   }
+  profiling.end("temp columns");
   loop.check();
 
   if (myLowTempCount > maxLowTempCount) {
@@ -60,6 +60,7 @@ IceModel::IceModel(IceGrid::Ptr g, Context::Ptr context)
     global_attributes("PISM_GLOBAL", m_sys),
     mapping("mapping", m_sys),
     run_stats("run_stats", m_sys),
+    m_active_cells(g, 1),
     extra_bounds("time_bounds", m_config->get_string("time_dimension_name"), m_sys),
     timestamp("timestamp", m_config->get_string("time_dimension_name"), m_sys) {
 
@@ -119,6 +120,8 @@ void IceModel::reset_counters() {
   CFLmaxdt2D   = 0.0;
   CFLviolcount = 0;
   dt_TempAge   = 0.0;
+
+  m_scalar_stats_valid = 0;
   dt_from_cfl  = 0.0;
 
   gmaxu = 0.0;
@@ -607,6 +610,10 @@ void IceModel::step(bool do_mass_continuity,
 
   double current_time = m_time->current();
 
+  // scalar diagnostics computed at the end of the previous step are
+  // about to become stale
+  m_scalar_stats_valid = 0;
+
   //! \li call additionalAtStartTimestep() to let derived classes do more
   additionalAtStartTimestep();  // might set dt_force,maxdt_temporary
 
@@ -672,7 +679,14 @@ void IceModel::step(bool do_mass_continuity,
   //!  see determineTimeStep()
   max_timestep(dt, skipCountDown);
 
-  //! \li Update surface and ocean models.
+  //! \li Update surface and ocean models. These updates use the
+  //! geometry from the beginning of the step but need the time step
+  //! length, which depends on the new velocity field (CFL and
+  //! diffusivity criteria) and on surface and ocean model time step
+  //! restrictions. This is why they cannot happen before (or during)
+  //! the stress balance update. Note that reading time-dependent forcing
+  //! is part of these updates; the cost of reads can be reduced using
+  //! climate_forcing_cache_directory, but it is not used by default.
   profiling.begin("surface");
   surface->update(current_time, dt);
   profiling.end("surface");
@@ -714,7 +728,8 @@ void IceModel::step(bool do_mass_continuity,
   combine_basal_melt_rate();
 
   //! \li update the state variables in the subglacial hydrology model (typically
-  //!  water thickness and sometimes pressure)
+  //!  water thickness and sometimes pressure); uses the basal melt rate
+  //!  combined above and the sliding velocity from the stress balance
   profiling.begin("basal hydrology");
   subglacial_hydrology->update(current_time, dt);
   profiling.end("basal hydrology");
@@ -830,6 +845,13 @@ void IceModel::run() {
 
   int stepcount = m_config->get_boolean("count_time_steps") ? 0 : -1;
 
+  const std::string profiling_report_file = m_config->get_string("profiling_report_file");
+  const int profiling_report_interval = m_config->get_double("profiling_report_interval");
+  int steps_since_profiling_report = 0;
+
+  const int memory_report_interval = m_config->get_double("memory_report_interval");
+  int steps_since_memory_report = 0;
+
   updateSurfaceElevationAndMask();
 
   // update diagnostics at the beginning of the run:
@@ -875,6 +897,22 @@ void IceModel::run() {
 
     update_viewers();
 
+    if (not profiling_report_file.empty() and profiling_report_interval > 0) {
+      steps_since_profiling_report += 1;
+      if (steps_since_profiling_report == profiling_report_interval) {
+        profiling.report(m_grid->com, profiling_report_file, m_time->date());
+        steps_since_profiling_report = 0;
+      }
+    }
+
+    if (memory_report_interval > 0) {
+      steps_since_memory_report += 1;
+      if (steps_since_memory_report == memory_report_interval) {
+        profiling.memory_report(m_grid->com, *m_log, 2);
+        steps_since_memory_report = 0;
+      }
+    }
+
     if (stepcount >= 0) {
       stepcount++;
     }
@@ -885,6 +923,12 @@ void IceModel::run() {
 
   profiling.stage_end("time-stepping loop");
 
+  check_load_balance();
+
+  if (not profiling_report_file.empty()) {
+    profiling.report(m_grid->com, profiling_report_file, m_time->date());
+  }
+
   options::Integer pause_time("-pause", "Pause after the run, seconds", 0);
   if (pause_time > 0) {
     m_log->message(2, "pausing for %d secs ...\n", pause_time.value());
@@ -908,6 +952,9 @@ explanations of their intended uses.
 void IceModel::init() {
   const Profiling &profiling = m_ctx->profiling();
 
+  // communication statistics are used in profiling reports only
+  profiling.set_communication_counting(not m_config->get_string("profiling_report_file").empty());
+
   profiling.begin("initialization");
 
   // Build PISM with -DPISM_WAIT_FOR_GDB=1 and run with -wait_for_gdb to
@@ -927,13 +974,19 @@ void IceModel::init() {
   setFromOptions();
 
   //! 3) Memory allocation:
-  createVecs();
+  {
+    MemoryScope scope(profiling, "model state");
+    createVecs();
+  }
 
   //! 4) Allocate PISM components modeling some physical processes.
   allocate_submodels();
 
   //! 5) Allocate work vectors:
-  allocate_internal_objects();
+  {
+    MemoryScope scope(profiling, "work space");
+    allocate_internal_objects();
+  }
 
   //! 6) Initialize coupler models and fill the model state variables
   //! (from a PISM output file, from a bootstrapping file using some
@@ -952,6 +1005,8 @@ void IceModel::init() {
   // across all processors.
   start_time = GlobalMax(m_grid->com, GetTime());
 
+  profiling.memory_report(m_grid->com, *m_log, 2);
+
   profiling.end("initialization");
 }
 
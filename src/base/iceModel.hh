@@ -44,6 +44,7 @@
 #include "base/util/Context.hh"
 #include "base/util/Logger.hh"
 #include "base/util/PISMTime.hh"
+#include "base/util/ActiveCells.hh"
 
 namespace pism {
 
@@ -102,6 +103,7 @@ class IceModel {
   friend class IceModel_tempicethk;
   friend class IceModel_tempicethk_basal;
   friend class IceModel_new_mask;
+  friend class IceModel_cell_cost;
   friend class IceModel_climatic_mass_balance_cumulative;
   friend class IceModel_dHdt;
   friend class IceModel_flux_divergence;
@@ -287,6 +289,9 @@ protected:
   IceModelVec2Int vMask, //!< \brief mask for flow type with values ice_free_bedrock,
   //!< grounded_ice, floating_ice, ice_free_ocean
     vBCMask; //!< mask to determine Dirichlet boundary locations
+
+  //! cells that are not in the open ocean (plus a one-cell halo); see updateSurfaceElevationAndMask()
+  ActiveCells m_active_cells;
  
   IceModelVec2V vBCvel; //!< Dirichlet boundary velocities
   
@@ -410,6 +415,8 @@ protected:
   virtual double compute_temperate_base_fraction(double ice_area);
   virtual double compute_original_ice_fraction(double ice_volume);
   virtual void summary(bool tempAndAge);
+  virtual void compute_cell_cost(IceModelVec2S &result);
+  virtual void check_load_balance();
   virtual void summaryPrintLine(bool printPrototype, bool tempAndAge,
                                 double delta_t,
                                 double volume, double area,
@@ -428,6 +435,26 @@ protected:
   virtual double compute_ice_area_floating();
   virtual double compute_ice_enthalpy();
 
+  //! Groups of scalar diagnostic quantities computed together (see scalar_stats()).
+  enum ScalarStatsGroup {STATS_GEOMETRY = 1, STATS_BASE = 2, STATS_ENERGY = 4};
+
+  //! Global integrals used by scalar diagnostics and the stdout summary.
+  struct ScalarStats {
+    ScalarStats();
+    // STATS_GEOMETRY: units of m3, m (sea level equivalent) and m2
+    double ice_volume, sealevel_volume, ice_area, ice_area_grounded, ice_area_floating;
+    // STATS_BASE: units of m2 and km2
+    double ice_area_temperate, ice_area_cold, temperate_base_area_km2;
+    // STATS_ENERGY: units of m3 and J
+    double ice_volume_temperate, ice_volume_cold, ice_enthalpy;
+  };
+  const ScalarStats& scalar_stats(unsigned int groups);
+  virtual void compute_scalar_stats(unsigned int groups, ScalarStats &result);
+
+  //! cached scalar diagnostics and the set of groups that are up to date
+  ScalarStats m_scalar_stats;
+  unsigned int m_scalar_stats_valid;
+
   // see iMtemp.cc
   virtual void excessToFromBasalMeltLayer(double rho, double c, double L,
                                           double z, double dz,
@@ -42,6 +42,7 @@ namespace pism {
 void IceModel::init_diagnostics() {
 
   // Add IceModel diagnostics:
+  diagnostics["cell_cost"]        = new IceModel_cell_cost(this);
   diagnostics["cts"]              = new IceModel_cts(this);
   diagnostics["enthalpybase"]     = new IceModel_enthalpybase(this);
   diagnostics["enthalpysurf"]     = new IceModel_enthalpysurf(this);
@@ -394,6 +395,27 @@ IceModelVec::Ptr IceModel_rank::compute() {
 }
 
 
+IceModel_cell_cost::IceModel_cell_cost(IceModel *m)
+  : Diag<IceModel>(m) {
+
+  // set metadata:
+  m_vars.push_back(SpatialVariableMetadata(m_sys, "cell_cost"));
+
+  set_attrs("estimated computational cost of a grid cell", "", "seconds", "", 0);
+}
+
+IceModelVec::Ptr IceModel_cell_cost::compute() {
+
+  IceModelVec2S::Ptr result(new IceModelVec2S);
+  result->create(m_grid, "cell_cost", WITHOUT_GHOSTS);
+  result->metadata() = m_vars[0];
+
+  model->compute_cell_cost(*result);
+
+  return result;
+}
+
+
 IceModel_cts::IceModel_cts(IceModel *m)
   : Diag<IceModel>(m) {
 
@@ -40,6 +40,14 @@ public:
   virtual IceModelVec::Ptr compute();
 };
 
+//! \brief Computes the estimated computational cost of grid cells (see IceModel::compute_cell_cost()).
+class IceModel_cell_cost : public Diag<IceModel>
+{
+public:
+  IceModel_cell_cost(IceModel *m);
+  virtual IceModelVec::Ptr compute();
+};
+
 //! \brief Computes CTS, CTS = E/E_s(p).
 class IceModel_cts : public Diag<IceModel>
 {
@@ -33,7 +33,7 @@ namespace pism {
 namespace stressbalance {
 
 SIAFD::SIAFD(IceGrid::ConstPtr g, EnthalpyConverter::Ptr e)
-  : SSB_Modifier(g, e) {
+  : SSB_Modifier(g, e), m_gradient_ghosts(g), m_velocity_ghosts(g) {
 
   const unsigned int WIDE_STENCIL = m_config->get_double("grid_max_stencil_width");
 
@@ -63,6 +63,12 @@ SIAFD::SIAFD(IceGrid::ConstPtr g, EnthalpyConverter::Ptr e)
   m_work_3d[0].create(m_grid, "work_3d_0", WITH_GHOSTS);
   m_work_3d[1].create(m_grid, "work_3d_1", WITH_GHOSTS);
 
+  m_gradient_ghosts.add(m_work_2d_stag[0]);
+  m_gradient_ghosts.add(m_work_2d_stag[1]);
+
+  m_velocity_ghosts.add(m_u);
+  m_velocity_ghosts.add(m_v);
+
   // bed smoother
   m_bed_smoother = new BedSmoother(m_grid, WIDE_STENCIL);
 
@@ -498,8 +504,12 @@ void SIAFD::surface_gradient_haseloff(IceModelVec2Stag &h_x, IceModelVec2Stag &h
     } // end of "y-derivative, i-offset"
   }
 
-  h_x.update_ghosts();
-  h_y.update_ghosts();
+  if (&h_x == &m_work_2d_stag[0] and &h_y == &m_work_2d_stag[1]) {
+    m_gradient_ghosts.update();
+  } else {
+    h_x.update_ghosts();
+    h_y.update_ghosts();
+  }
 }
 
 
@@ -903,6 +913,8 @@ void SIAFD::compute_3d_horizontal_velocity(const IceModelVec2Stag &h_x, const Ic
   compute_I();
   // after the compute_I() call work_3d[0,1] contains I on the staggered grid
   IceModelVec3 *I = m_work_3d;
+  // ... and work_2d[0] contains the smoothed ice thickness
+  const IceModelVec2S &thk_smooth = m_work_2d[0];
 
   IceModelVec::AccessList list;
   list.add(u_out);
@@ -914,10 +926,22 @@ void SIAFD::compute_3d_horizontal_velocity(const IceModelVec2Stag &h_x, const Ic
 
   list.add(I[0]);
   list.add(I[1]);
+  list.add(thk_smooth);
 
   for (Points p(*m_grid); p; p.next()) {
     const int i = p.i(), j = p.j();
 
+    // I is zero at all four staggered points around an ice-free cell
+    // with ice-free neighbors, so the velocity is equal to vel_input
+    // throughout the column.
+    if (thk_smooth(i, j) == 0.0 &&
+        thk_smooth(i + 1, j) == 0.0 && thk_smooth(i - 1, j) == 0.0 &&
+        thk_smooth(i, j + 1) == 0.0 && thk_smooth(i, j - 1) == 0.0) {
+      u_out.set_column(i, j, vel_input(i, j).u);
+      v_out.set_column(i, j, vel_input(i, j).v);
+      continue;
+    }
+
     double
       *I_e = I[0].get_column(i, j),
       *I_w = I[0].get_column(i - 1, j),
@@ -958,8 +982,12 @@ void SIAFD::compute_3d_horizontal_velocity(const IceModelVec2Stag &h_x, const Ic
   }
 
   // Communicate to get ghosts:
-  u_out.update_ghosts();
-  v_out.update_ghosts();
+  if (&u_out == &m_u and &v_out == &m_v) {
+    m_velocity_ghosts.update();
+  } else {
+    u_out.update_ghosts();
+    v_out.update_ghosts();
+  }
 }
 
 //! Use the Vostok core as a source of a relationship between the age of the ice and the grain size.
@@ -20,6 +20,7 @@
 #define _SIAFD_H_
 
 #include "base/stressbalance/SSB_Modifier.hh"      // derivesfrom SSB_Modifier
+#include "base/util/GhostExchangeGroup.hh"
 
 namespace pism {
 
@@ -105,6 +106,11 @@ protected:
   //! temporary storage used to store I and strain_heating on the staggered grid
   IceModelVec3 m_work_3d[2];
 
+  //! ghost updates of the surface gradient (m_work_2d_stag)
+  GhostExchangeGroup m_gradient_ghosts;
+  //! ghost updates of the horizontal velocity (m_u, m_v)
+  GhostExchangeGroup m_velocity_ghosts;
+
   BedSmoother *m_bed_smoother;
   int m_bed_state_counter;
 
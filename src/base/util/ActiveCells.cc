@@ -0,0 +1,75 @@
+/* Copyright (C) 2015 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "ActiveCells.hh"
+#include "base/util/iceModelVec.hh"
+#include "base/util/Mask.hh"
+#include "base/util/error_handling.hh"
+
+namespace pism {
+
+ActiveCells::ActiveCells(IceGrid::ConstPtr g, unsigned int width)
+  : CellList(g, width) {
+  // empty
+}
+
+//! True in cells that are not "empty" (see ActiveCells).
+class NonEmpty {
+public:
+  NonEmpty(const IceModelVec2Int &mask, const IceModelVec2S &thickness)
+    : m_mask(mask), m_thickness(thickness) {
+    // empty
+  }
+
+  bool operator()(int i, int j) const {
+    return not (mask::ice_free_ocean(m_mask.as_int(i, j)) and
+                m_thickness(i, j) == 0.0);
+  }
+private:
+  const IceModelVec2Int &m_mask;
+  const IceModelVec2S &m_thickness;
+};
+
+/**
+ * Re-build the list of active cells.
+ *
+ * Uses ghosts of `mask` and `thickness` (`width` of them).
+ *
+ * @param[in] mask cell type mask
+ * @param[in] thickness ice thickness
+ */
+void ActiveCells::update(const IceModelVec2Int &mask, const IceModelVec2S &thickness) {
+
+  if (mask.get_stencil_width() < m_width or
+      thickness.get_stencil_width() < m_width) {
+    throw RuntimeError::formatted("fields '%s' and '%s' have stencil widths %d and %d, need %d",
+                                  mask.get_name().c_str(), thickness.get_name().c_str(),
+                                  mask.get_stencil_width(), thickness.get_stencil_width(),
+                                  m_width);
+  }
+
+  const int w = m_width;
+
+  IceModelVec::AccessList list(mask);
+  list.add(thickness);
+
+  build(NonEmpty(mask, thickness), 1, (2 * w + 1) * (2 * w + 1));
+}
+
+} // end of namespace pism
@@ -0,0 +1,56 @@
+/* Copyright (C) 2015 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _ACTIVECELLS_H_
+#define _ACTIVECELLS_H_
+
+#include "base/util/CellList.hh"
+
+namespace pism {
+
+class IceModelVec2Int;
+class IceModelVec2S;
+
+/*! \brief List of grid cells (owned by this processor) that are not in the open ocean. */
+/*!
+ * A cell is "empty" if it is ice-free ocean *and* has zero ice
+ * thickness. A cell is "active" if there is at least one non-empty
+ * cell within `width` cells of it (in the max-norm).
+ *
+ * Kernels using a stencil of width `width` can skip inactive cells:
+ * there is no ice to move there, no ice can flow in from neighbors,
+ * and ice-free ocean gets neither surface mass balance nor basal
+ * melt.
+ *
+ * Unlike calving::FrontIndex the list is not re-built automatically:
+ * the ice thickness is modified in place in many places without
+ * incrementing its state counter, so the code changing the geometry
+ * has to call update() (see IceModel::updateSurfaceElevationAndMask()).
+ * Use CellListPoints to iterate over active cells.
+ */
+class ActiveCells : public CellList {
+public:
+  ActiveCells(IceGrid::ConstPtr g, unsigned int width);
+
+  void update(const IceModelVec2Int &mask, const IceModelVec2S &thickness);
+};
+
+} // end of namespace pism
+
+#endif /* _ACTIVECELLS_H_ */
@@ -0,0 +1,149 @@
+/* Copyright (C) 2015 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _CELLLIST_H_
+#define _CELLLIST_H_
+
+#include <vector>
+#include <cassert>
+
+#include "base/util/IceGrid.hh"
+
+namespace pism {
+
+/*! \brief List of grid cells (owned by this processor) selected by
+ *  counting cells with a certain property in a neighborhood.
+ */
+/*!
+ * A cell is included if the number `N` of cells within `width` cells
+ * of it (in the max-norm) for which an indicator is true satisfies
+ * `N_min <= N <= N_max`. For example, cells near the ice margin are
+ * the ones with `0 < N < (2*width+1)^2` if the indicator is "icy".
+ *
+ * The list is sorted in the order used by `Points`, so iterating over
+ * it instead of the whole grid does not change results of kernels
+ * that modify fields in place.
+ *
+ * Derived classes decide when to re-build the list and call build().
+ */
+class CellList {
+public:
+  CellList(IceGrid::ConstPtr g, unsigned int width);
+  virtual ~CellList();
+
+  unsigned int width() const;
+  unsigned int size() const;
+protected:
+  template<class Indicator>
+  void build(const Indicator &indicator, int N_min, int N_max);
+
+  IceGrid::ConstPtr m_grid;
+  unsigned int m_width;
+private:
+  friend class CellListPoints;
+
+  std::vector<int> m_i, m_j;
+  //! temporary storage for row sums of the indicator
+  std::vector<int> m_row_sums;
+};
+
+/**
+ * Re-build the list.
+ *
+ * We count cells in (2*width+1)x(2*width+1) windows using row sums,
+ * which makes the cost of an update independent of the width.
+ *
+ * `indicator(i, j)` has to be valid in `width` ghost points; the
+ * caller is responsible for accessing fields it uses (see
+ * IceModelVec::AccessList).
+ *
+ * @param[in] indicator function object returning true for cells that are counted
+ * @param[in] N_min minimum number of such cells in the window
+ * @param[in] N_max maximum number of such cells in the window
+ */
+template<class Indicator>
+void CellList::build(const Indicator &indicator, int N_min, int N_max) {
+  const int
+    w  = m_width,
+    xs = m_grid->xs(),
+    xm = m_grid->xm(),
+    ys = m_grid->ys(),
+    ym = m_grid->ym();
+
+  m_row_sums.resize((xm + 2 * w) * ym);
+  m_i.clear();
+  m_j.clear();
+
+  // number of cells in [j - w, j + w], for all i (including ghosts)
+  for (int i = xs - w; i < xs + xm + w; ++i) {
+    for (int j = ys; j < ys + ym; ++j) {
+      int sum = 0;
+      for (int k = -w; k <= w; ++k) {
+        sum += indicator(i, j + k) ? 1 : 0;
+      }
+      m_row_sums[(i - xs + w) * ym + (j - ys)] = sum;
+    }
+  }
+
+  for (Points p(*m_grid); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    int N = 0;
+    for (int k = -w; k <= w; ++k) {
+      N += m_row_sums[(i + k - xs + w) * ym + (j - ys)];
+    }
+
+    if (N >= N_min and N <= N_max) {
+      m_i.push_back(i);
+      m_j.push_back(j);
+    }
+  }
+}
+
+//! Iterator over cells in a CellList (see the class Points).
+class CellListPoints {
+public:
+  CellListPoints(const CellList &list)
+    : m_list(list), m_k(0) {
+    // empty
+  }
+
+  int i() const {
+    return m_list.m_i[m_k];
+  }
+  int j() const {
+    return m_list.m_j[m_k];
+  }
+
+  void next() {
+    assert(m_k < m_list.m_i.size());
+    m_k += 1;
+  }
+
+  operator bool() const {
+    return m_k < m_list.m_i.size();
+  }
+private:
+  const CellList &m_list;
+  size_t m_k;
+};
+
+} // end of namespace pism
+
+#endif /* _CELLLIST_H_ */
@@ -0,0 +1,198 @@
+/* Copyright (C) 2015 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <petscdmda.h>
+
+#include "GhostExchangeGroup.hh"
+#include "base/util/iceModelVec.hh"
+#include "base/util/error_handling.hh"
+#include "base/util/Context.hh"
+#include "base/util/Profiling.hh"
+#include "base/util/pism_const.hh"
+
+namespace pism {
+
+//! Number of degrees of freedom of the DM used by `field`.
+/*!
+ * 2D fields have `m_dof` components and one level; 3D fields have one
+ * component and `zlevels.size()` levels.
+ */
+static unsigned int dm_dof(const IceModelVec &field) {
+  return field.get_ndof() * field.get_levels().size();
+}
+
+GhostExchangeGroup::GhostExchangeGroup(IceGrid::ConstPtr grid)
+  : m_grid(grid), m_dof(0), m_stencil_width(0) {
+  // empty
+}
+
+//! Add a field to the group. The field has to have ghosts.
+void GhostExchangeGroup::add(IceModelVec &field) {
+  if (not field.m_has_ghosts) {
+    throw RuntimeError::formatted("cannot add '%s' to a ghost exchange group: it has no ghosts",
+                                  field.get_name().c_str());
+  }
+
+  if (field.get_grid().get() != m_grid.get()) {
+    throw RuntimeError::formatted("cannot add '%s' to a ghost exchange group: grids differ",
+                                  field.get_name().c_str());
+  }
+
+  if (m_fields.empty()) {
+    m_stencil_width = field.m_da_stencil_width;
+  } else if (field.m_da_stencil_width != m_stencil_width) {
+    throw RuntimeError::formatted("cannot add '%s' to a ghost exchange group:"
+                                  " stencil width %d does not match %d",
+                                  field.get_name().c_str(),
+                                  field.m_da_stencil_width, m_stencil_width);
+  }
+
+  m_fields.push_back(&field);
+  m_dof += dm_dof(field);
+
+  // re-allocate during the next update() call
+  m_da.reset();
+}
+
+void GhostExchangeGroup::allocate() {
+  m_da = m_grid->get_dm(m_dof, m_stencil_width);
+
+  PetscErrorCode ierr = DMCreateLocalVector(*m_da, m_buffer.rawptr());
+  PISM_CHK(ierr, "DMCreateLocalVector");
+}
+
+//! Update ghosts of all fields in the group.
+void GhostExchangeGroup::update() {
+  if (m_fields.empty()) {
+    return;
+  }
+
+  if (not m_da) {
+    allocate();
+  }
+
+  const Profiling &profiling = m_grid->ctx()->profiling();
+
+  bool current = true;
+  for (unsigned int f = 0; f < m_fields.size(); ++f) {
+    current = current and m_fields[f]->ghosts_are_current();
+  }
+
+  // skip the exchange if none of the fields changed since their last ghost update
+  if (current) {
+    if (profiling.communication_counting()) {
+      profiling.communication("update_ghosts", names(), 0.0, 0.0, true);
+    }
+    return;
+  }
+
+  PetscErrorCode ierr;
+
+  const double start = MPI_Wtime();
+
+  // pack
+  {
+    petsc::VecArray buffer(m_buffer);
+    double *b = buffer.get();
+    unsigned int offset = 0;
+    for (unsigned int f = 0; f < m_fields.size(); ++f) {
+      IceModelVec &field = *m_fields[f];
+      const unsigned int dof = dm_dof(field);
+
+      PetscInt size = 0;
+      ierr = VecGetLocalSize(field.m_v, &size);
+      PISM_CHK(ierr, "VecGetLocalSize");
+
+      petsc::VecArray input(field.m_v);
+      const double *x = input.get();
+      const unsigned int N = size / dof;
+      for (unsigned int p = 0; p < N; ++p) {
+        for (unsigned int k = 0; k < dof; ++k) {
+          b[p * m_dof + offset + k] = x[p * dof + k];
+        }
+      }
+      offset += dof;
+    }
+  }
+
+#if PETSC_VERSION_LT(3,5,0)
+  ierr = DMDALocalToLocalBegin(*m_da, m_buffer, INSERT_VALUES, m_buffer);
+  PISM_CHK(ierr, "DMDALocalToLocalBegin");
+
+  ierr = DMDALocalToLocalEnd(*m_da, m_buffer, INSERT_VALUES, m_buffer);
+  PISM_CHK(ierr, "DMDALocalToLocalEnd");
+#else
+  ierr = DMLocalToLocalBegin(*m_da, m_buffer, INSERT_VALUES, m_buffer);
+  PISM_CHK(ierr, "DMLocalToLocalBegin");
+
+  ierr = DMLocalToLocalEnd(*m_da, m_buffer, INSERT_VALUES, m_buffer);
+  PISM_CHK(ierr, "DMLocalToLocalEnd");
+#endif
+
+  // unpack
+  {
+    petsc::VecArray buffer(m_buffer);
+    const double *b = buffer.get();
+    unsigned int offset = 0;
+    for (unsigned int f = 0; f < m_fields.size(); ++f) {
+      IceModelVec &field = *m_fields[f];
+      const unsigned int dof = dm_dof(field);
+
+      PetscInt size = 0;
+      ierr = VecGetLocalSize(field.m_v, &size);
+      PISM_CHK(ierr, "VecGetLocalSize");
+
+      petsc::VecArray output(field.m_v);
+      double *x = output.get();
+      const unsigned int N = size / dof;
+      for (unsigned int p = 0; p < N; ++p) {
+        for (unsigned int k = 0; k < dof; ++k) {
+          x[p * dof + k] = b[p * m_dof + offset + k];
+        }
+      }
+      offset += dof;
+    }
+  }
+
+  for (unsigned int f = 0; f < m_fields.size(); ++f) {
+    m_fields[f]->ghosts_updated();
+  }
+
+  // record one exchange per group; the time includes packing and unpacking
+  if (profiling.communication_counting()) {
+    double bytes = 0.0;
+    for (unsigned int f = 0; f < m_fields.size(); ++f) {
+      IceModelVec &field = *m_fields[f];
+      bytes += field.ghost_bytes(field.m_v);
+    }
+    profiling.communication("update_ghosts", names(), bytes,
+                            MPI_Wtime() - start, false);
+  }
+}
+
+//! Comma-separated names of fields in the group (used in the profiling report).
+std::string GhostExchangeGroup::names() const {
+  std::vector<std::string> result;
+  for (unsigned int f = 0; f < m_fields.size(); ++f) {
+    result.push_back(m_fields[f]->get_name());
+  }
+  return join(result, ",");
+}
+
+} // end of namespace pism
@@ -0,0 +1,82 @@
+/* Copyright (C) 2015 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GHOSTEXCHANGEGROUP_H_
+#define _GHOSTEXCHANGEGROUP_H_
+
+#include <vector>
+
+#include "base/util/IceGrid.hh"
+#include "base/util/petscwrappers/DM.hh"
+#include "base/util/petscwrappers/Vec.hh"
+
+namespace pism {
+
+class IceModelVec;
+
+//! \brief Updates ghosts of several fields using one message per neighbor.
+/*!
+ * Each IceModelVec::update_ghosts() call sends its own messages, so
+ * updating N fields back to back costs N times the latency. This
+ * class packs all fields in a group into one buffer (using a DM with
+ * the combined number of degrees of freedom), updates ghosts of this
+ * buffer and unpacks.
+ *
+ * Fields have to use the same grid and stencil width, but may differ
+ * in the number of degrees of freedom (2D, staggered, 3D).
+ *
+ * @code
+ * GhostExchangeGroup group(grid);
+ * group.add(u);
+ * group.add(v);
+ * // ...
+ * group.update();  // same as u.update_ghosts(); v.update_ghosts();
+ * @endcode
+ *
+ * Keep groups around: the buffer and the DM are allocated during the
+ * first update() call.
+ */
+class GhostExchangeGroup {
+public:
+  GhostExchangeGroup(IceGrid::ConstPtr grid);
+
+  void add(IceModelVec &field);
+
+  void update();
+private:
+  void allocate();
+  std::string names() const;
+
+  IceGrid::ConstPtr m_grid;
+  std::vector<IceModelVec*> m_fields;
+  //! combined number of degrees of freedom of fields in the group
+  unsigned int m_dof;
+  unsigned int m_stencil_width;
+
+  petsc::DM::Ptr m_da;
+  petsc::Vec m_buffer;
+
+  // Hide copy constructor / assignment operator.
+  GhostExchangeGroup(const GhostExchangeGroup &);
+  GhostExchangeGroup & operator=(const GhostExchangeGroup &);
+};
+
+} // end of namespace pism
+
+#endif /* _GHOSTEXCHANGEGROUP_H_ */
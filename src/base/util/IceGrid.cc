@@ -17,6 +17,7 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <map>
+#include <algorithm>
 #include <petscsys.h>
 #include <gsl/gsl_interp.h>
 
@@ -299,7 +300,13 @@ IceGrid::Ptr IceGrid::FromFile(Context::Ptr ctx,
 
     // override periodicity
     p.periodicity = periodicity;
-    p.ownership_ranges_from_options(ctx->size());
+    if (ctx->config()->get_boolean("grid_ice_aware_decomposition")) {
+      PIO file(ctx->com(), "netcdf3");
+      file.open(filename, PISM_READONLY); // will be closed automatically
+      p.ownership_ranges_from_file(ctx, file);
+    } else {
+      p.ownership_ranges_from_options(ctx->size());
+    }
 
     return IceGrid::Ptr(new IceGrid(ctx, p));
   } catch (RuntimeError &e) {
@@ -446,6 +453,45 @@ static std::vector<unsigned int> ownership_ranges(unsigned int Mx,
   return result;
 }
 
+//! \brief Computes processor ownership ranges so that each part has about
+//! the same total weight.
+/*!
+ * `weights` contains weights of grid points along one direction. Each
+ * part gets at least `min_width` points. Falls back to the equal area
+ * distribution if that is not possible or if all weights are zero.
+ */
+std::vector<unsigned int> weighted_ownership_ranges(const std::vector<double> &weights,
+                                                    unsigned int N,
+                                                    unsigned int min_width) {
+  const unsigned int M = weights.size();
+
+  // partial sums: S[k] is the total weight of points 0, ..., k-1
+  std::vector<double> S(M + 1, 0.0);
+  for (unsigned int k = 0; k < M; ++k) {
+    S[k + 1] = S[k] + weights[k];
+  }
+
+  if (S[M] <= 0.0 or N * min_width > M) {
+    return ownership_ranges(M, N);
+  }
+
+  std::vector<unsigned int> result(N);
+  unsigned int start = 0;
+  for (unsigned int k = 1; k < N; ++k) {
+    const double target = S[M] * k / N;
+
+    unsigned int end = std::lower_bound(S.begin(), S.end(), target) - S.begin();
+    end = std::max(end, start + min_width);
+    end = std::min(end, M - (N - k) * min_width);
+
+    result[k - 1] = end - start;
+    start = end;
+  }
+  result[N - 1] = M - start;
+
+  return result;
+}
+
 //! Set processor ownership ranges. Takes care of type conversion (`unsigned int` -> `PetscInt`).
 void IceGrid::set_ownership_ranges(const std::vector<unsigned int> &procs_x,
                                    const std::vector<unsigned int> &procs_y) {
@@ -468,11 +514,25 @@ struct OwnershipRanges {
   std::vector<unsigned int> x, y;
 };
 
+//! Expected amount of work summed over columns (`x`, length Mx) and rows (`y`, length My).
+struct OwnershipWeights {
+  std::vector<double> x, y;
+};
+
 //! Compute processor ownership ranges using the grid size, MPI communicator size, and command-line
 //! options `-Nx`, `-Ny`, `-procs_x`, `-procs_y`.
+/*!
+ * If `weights` is not NULL, it contains the expected amount of work
+ * summed over columns and rows of the grid. Ranges not set using
+ * `-procs_x` and `-procs_y` are then chosen to balance the work.
+ * Because PETSc requires a tensor-product decomposition, this
+ * balances sums over rows and columns, not over individual patches.
+ */
 static OwnershipRanges compute_ownership_ranges(unsigned int Mx,
                                                 unsigned int My,
-                                                unsigned int size) {
+                                                unsigned int size,
+                                                const OwnershipWeights *weights = NULL,
+                                                unsigned int min_width = 2) {
   OwnershipRanges result;
 
   unsigned int Nx_default, Ny_default;
@@ -512,6 +572,8 @@ static OwnershipRanges compute_ownership_ranges(unsigned int Mx,
       result.x[k] = procs_x[k];
     }
 
+  } else if (weights != NULL) {
+    result.x = weighted_ownership_ranges(weights->x, Nx, min_width);
   } else {
     result.x = ownership_ranges(Mx, Nx);
   }
@@ -525,6 +587,8 @@ static OwnershipRanges compute_ownership_ranges(unsigned int Mx,
     for (unsigned int k = 0; k < procs_y->size(); ++k) {
       result.y[k] = procs_y[k];
     }
+  } else if (weights != NULL) {
+    result.y = weighted_ownership_ranges(weights->y, Ny, min_width);
   } else {
     result.y = ownership_ranges(My, Ny);
   }
@@ -832,6 +896,16 @@ unsigned int IceGrid::size() const {
   return m_impl->size;
 }
 
+//! Number of processors in the x direction.
+unsigned int IceGrid::Nx() const {
+  return m_impl->procs_x.size();
+}
+
+//! Number of processors in the y direction.
+unsigned int IceGrid::Ny() const {
+  return m_impl->procs_y.size();
+}
+
 //! Dictionary of variables (2D and 3D fields) associated with this grid.
 Vars& IceGrid::variables() {
   return m_impl->variables;
@@ -1137,6 +1211,140 @@ void GridParameters::ownership_ranges_from_options(unsigned int size) {
   procs_y = procs.y;
 }
 
+//! Read the expected amount of work per column from `file`.
+/*!
+ * Uses `cell_cost` (measured during a previous run, see
+ * IceModel::compute_cell_cost()) if present. Otherwise uses the ice
+ * thickness: an icy column costs `grid_ice_column_cost` times as much
+ * as an ice-free one.
+ *
+ * The file may use a different grid; we use the nearest (lower left)
+ * value.
+ *
+ * Only processor 0 reads the field and sums it over columns and rows;
+ * other processors get these sums (Mx + My numbers) using MPI_Bcast.
+ *
+ * Returns `false` if `file` contains neither field.
+ */
+static bool ownership_weights(Context::ConstPtr ctx, const PIO &file,
+                              unsigned int Mx, unsigned int My,
+                              OwnershipWeights &result) {
+  const bool cost_map = file.inq_var("cell_cost");
+
+  std::string name = "cell_cost";
+  if (not cost_map) {
+    bool exists = false, found_by_standard_name = false;
+    file.inq_var("thk", "land_ice_thickness", exists, name, found_by_standard_name);
+    if (not exists) {
+      ctx->log()->message(2,
+                          "* '%s' contains neither cell_cost nor land_ice_thickness;"
+                          " using equal area domain decomposition.\n",
+                          file.inq_filename().c_str());
+      return false;
+    }
+  }
+
+  const bool rank0 = ctx->rank() == 0;
+
+  // read the last record of a 2D field (processor 0 only: others read
+  // zero values)
+  std::vector<std::string> dims = file.inq_vardims(name);
+  std::vector<unsigned int> start(dims.size()), count(dims.size());
+  int x_index = -1, y_index = -1;
+  unsigned int x_length = 0, y_length = 0;
+  for (unsigned int k = 0; k < dims.size(); ++k) {
+    const unsigned int length = file.inq_dimlen(dims[k]);
+
+    switch (file.inq_dimtype(dims[k], ctx->unit_system())) {
+    case X_AXIS:
+      start[k] = 0;
+      count[k] = rank0 ? length : 0;
+      x_index  = k;
+      x_length = length;
+      break;
+    case Y_AXIS:
+      start[k] = 0;
+      count[k] = rank0 ? length : 0;
+      y_index  = k;
+      y_length = length;
+      break;
+    case T_AXIS:
+      start[k] = length > 0 ? length - 1 : 0;
+      count[k] = 1;
+      break;
+    default:
+      start[k] = 0;
+      count[k] = 1;
+    }
+  }
+
+  if (x_index < 0 or y_index < 0) {
+    throw RuntimeError::formatted("variable '%s' in '%s' is not a 2D field",
+                                  name.c_str(), file.inq_filename().c_str());
+  }
+
+  // allocate at least one element so that &data[0] is valid on all processors
+  std::vector<double> data(rank0 ? x_length * y_length : 1);
+  file.get_vara_double(name, start, count, &data[0]);
+
+  result.x.assign(Mx, 0.0);
+  result.y.assign(My, 0.0);
+
+  if (rank0) {
+    const double ice_cost = ctx->config()->get_double("grid_ice_column_cost");
+
+    for (unsigned int i = 0; i < Mx; ++i) {
+      const unsigned int I = (unsigned long)i * x_length / Mx;
+      for (unsigned int j = 0; j < My; ++j) {
+        const unsigned int J = (unsigned long)j * y_length / My;
+
+        const double value = (x_index < y_index ?
+                              data[I * y_length + J] :
+                              data[J * x_length + I]);
+
+        double weight = 0.0;
+        if (cost_map) {
+          weight = std::max(value, 0.0);
+        } else {
+          weight = value > 0.0 ? ice_cost : 1.0;
+        }
+
+        result.x[i] += weight;
+        result.y[j] += weight;
+      }
+    }
+  }
+
+  MPI_Bcast(&result.x[0], Mx, MPI_DOUBLE, 0, ctx->com());
+  MPI_Bcast(&result.y[0], My, MPI_DOUBLE, 0, ctx->com());
+
+  ctx->log()->message(2,
+                      "* Using ice-aware domain decomposition (weights from '%s' in '%s').\n",
+                      name.c_str(), file.inq_filename().c_str());
+
+  return true;
+}
+
+//! Compute ownership ranges so that processors get similar amounts of work.
+/*!
+ * See ownership_weights() and compute_ownership_ranges(). Uses current
+ * values of Mx and My.
+ */
+void GridParameters::ownership_ranges_from_file(Context::ConstPtr ctx, const PIO &file) {
+  const unsigned int min_width = std::max(2, (int)ctx->config()->get_double("grid_max_stencil_width"));
+
+  OwnershipWeights weights;
+
+  if (not ownership_weights(ctx, file, Mx, My, weights)) {
+    ownership_ranges_from_options(ctx->size());
+    return;
+  }
+
+  OwnershipRanges procs = compute_ownership_ranges(Mx, My, ctx->size(), &weights, min_width);
+  procs_x = procs.x;
+  procs_y = procs.y;
+}
+
 //! Initialize from a configuration database. Does not try to compute ownership ranges.
 void GridParameters::init_from_config(Config::ConstPtr config) {
   Lx = config->get_double("grid_Lx");
@@ -1355,7 +1563,11 @@ IceGrid::Ptr IceGrid::FromOptions(Context::Ptr ctx) {
     input_grid.horizontal_size_from_options();
     input_grid.horizontal_extent_from_options();
     input_grid.vertical_grid_from_options(ctx->config());
-    input_grid.ownership_ranges_from_options(ctx->size());
+    if (ctx->config()->get_boolean("grid_ice_aware_decomposition")) {
+      input_grid.ownership_ranges_from_file(ctx, nc);
+    } else {
+      input_grid.ownership_ranges_from_options(ctx->size());
+    }
 
     return IceGrid::Ptr(new IceGrid(ctx, input_grid));
   } else {
@@ -47,6 +47,10 @@ std::string periodicity_to_string(Periodicity p);
 SpacingType string_to_spacing(const std::string &keyword);
 std::string spacing_to_string(SpacingType s);
 
+std::vector<unsigned int> weighted_ownership_ranges(const std::vector<double> &weights,
+                                                    unsigned int N,
+                                                    unsigned int min_width);
+
 //! @brief Contains parameters of an input file grid.
 class grid_info {
 public:
@@ -108,6 +112,8 @@ public:
   void vertical_grid_from_options(Config::ConstPtr config);
   //! Re-compute ownership ranges. Uses current values of Mx and My.
   void ownership_ranges_from_options(unsigned int size);
+  //! Re-compute ownership ranges using the expected work per column read from a file.
+  void ownership_ranges_from_file(Context::ConstPtr ctx, const PIO &file);
 
   //! Validate data members.
   void validate() const;
@@ -272,6 +278,8 @@ public:
 
   unsigned int size() const;
   int rank() const;
+  unsigned int Nx() const;
+  unsigned int Ny() const;
 
   const MPI_Comm com;
 
@@ -298,12 +306,20 @@ double radius(const IceGrid &grid, int i, int j);
 
 //! @brief Check if a point `(i,j)` is in the strip of `stripwidth`
 //! meters around the edge of the computational domain.
+//!
+//! Indices of ghost points (including ones outside of `[0, Mx-1]` and `[0, My-1]`)
+//! are mapped to the corresponding points of the periodic grid.
 inline bool in_null_strip(const IceGrid& grid, int i, int j, double strip_width) {
-  return (strip_width >= 0.0                               &&
-          (grid.x(i)  <= grid.x(0) + strip_width           ||
-           grid.x(i)  >= grid.x(grid.Mx()-1) - strip_width ||
-           grid.y(j)  <= grid.y(0) + strip_width           ||
-           grid.y(j)  >= grid.y(grid.My()-1) - strip_width));
+  if (strip_width < 0.0) {
+    return false;
+  }
+  const int Mx = grid.Mx(), My = grid.My();
+  i = ((i % Mx) + Mx) % Mx;
+  j = ((j % My) + My) % My;
+  return (grid.x(i)  <= grid.x(0) + strip_width    ||
+          grid.x(i)  >= grid.x(Mx - 1) - strip_width ||
+          grid.y(j)  <= grid.y(0) + strip_width    ||
+          grid.y(j)  >= grid.y(My - 1) - strip_width);
 }
 
 /** Iterator class for traversing the grid, including ghost points.
@@ -365,6 +381,123 @@ public:
   Points(const IceGrid &g) : PointsWithGhosts(g, 0) {}
 };
 
+/** Iterator over points owned by this processor that are at least
+ * `width` points away from the boundary of its patch.
+ *
+ * A stencil of width `width` centered at these points does not use
+ * ghosts, so they can be processed while ghosts are being updated
+ * (see IceModelVec::update_ghosts_begin()). Use RimPoints to process
+ * the rest.
+ */
+class InteriorPoints {
+public:
+  InteriorPoints(const IceGrid &g, unsigned int width) {
+    m_i_first = g.xs() + width;
+    m_i_last  = g.xs() + g.xm() - width - 1;
+    m_j_first = g.ys() + width;
+    m_j_last  = g.ys() + g.ym() - width - 1;
+
+    m_i = m_i_first;
+    m_j = m_j_first;
+    m_done = (m_i_first > m_i_last or m_j_first > m_j_last);
+  }
+
+  int i() const {
+    return m_i;
+  }
+  int j() const {
+    return m_j;
+  }
+
+  void next() {
+    assert(m_done == false);
+    m_j += 1;
+    if (m_j > m_j_last) {
+      m_j = m_j_first;        // wrap around
+      m_i += 1;
+    }
+    if (m_i > m_i_last) {
+      m_i = m_i_first;        // ensure that indexes are valid
+      m_done = true;
+    }
+  }
+
+  operator bool() const {
+    return m_done == false;
+  }
+private:
+  int m_i, m_j;
+  int m_i_first, m_i_last, m_j_first, m_j_last;
+  bool m_done;
+};
+
+/** Iterator over points owned by this processor that are *not* visited
+ * by InteriorPoints with the same `width`.
+ */
+class RimPoints {
+public:
+  RimPoints(const IceGrid &g, unsigned int width) {
+    m_i_first = g.xs();
+    m_i_last  = g.xs() + g.xm() - 1;
+    m_j_first = g.ys();
+    m_j_last  = g.ys() + g.ym() - 1;
+
+    // the interior, possibly empty
+    m_i_interior_first = m_i_first + width;
+    m_i_interior_last  = m_i_last - width;
+    m_j_interior_first = m_j_first + width;
+    m_j_interior_last  = m_j_last - width;
+
+    m_i = m_i_first;
+    m_j = m_j_first;
+    m_done = (m_i_first > m_i_last or m_j_first > m_j_last);
+    skip_interior();
+  }
+
+  int i() const {
+    return m_i;
+  }
+  int j() const {
+    return m_j;
+  }
+
+  void next() {
+    assert(m_done == false);
+    m_j += 1;
+    skip_interior();
+  }
+
+  operator bool() const {
+    return m_done == false;
+  }
+private:
+  //! Move to the next point that is not in the interior (if necessary).
+  void skip_interior() {
+    while (not m_done) {
+      if (m_i >= m_i_interior_first and m_i <= m_i_interior_last and
+          m_j >= m_j_interior_first and m_j <= m_j_interior_last) {
+        m_j = m_j_interior_last + 1;
+      }
+
+      if (m_j <= m_j_last) {
+        break;
+      }
+
+      m_j = m_j_first;        // wrap around
+      m_i += 1;
+      if (m_i > m_i_last) {
+        m_i = m_i_first;      // ensure that indexes are valid
+        m_done = true;
+      }
+    }
+  }
+
+  int m_i, m_j;
+  int m_i_first, m_i_last, m_j_first, m_j_last;
+  int m_i_interior_first, m_i_interior_last, m_j_interior_first, m_j_interior_last;
+  bool m_done;
+};
+
 } // end of namespace pism
 
 #endif  /* __grid_hh */
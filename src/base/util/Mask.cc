@@ -23,7 +23,7 @@
 
 namespace pism {
 
-void GeometryCalculator::compute(IceModelVec2S &bed, IceModelVec2S &thickness,
+void GeometryCalculator::compute(const IceModelVec2S &bed, const IceModelVec2S &thickness,
                                  IceModelVec2Int &out_mask, IceModelVec2S &out_surface)
 {
   IceModelVec::AccessList list;
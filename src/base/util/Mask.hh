@@ -76,7 +76,7 @@ public:
     is_floating_thickness = config.get_double("mask_is_floating_thickness_standard");
   }
 
-  void compute(IceModelVec2S &in_bed, IceModelVec2S &in_thickness,
+  void compute(const IceModelVec2S &in_bed, const IceModelVec2S &in_thickness,
                IceModelVec2Int &out_mask, IceModelVec2S &out_surface);
 
   inline void compute(double bed, double thickness,
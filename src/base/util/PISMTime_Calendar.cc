@@ -19,6 +19,7 @@
 #include <cassert>
 #include <sstream>
 #include <cstdlib>
+#include <algorithm>
 
 #include "error_handling.hh"
 
@@ -48,6 +49,19 @@ static inline std::string string_strip(std::string input) {
   return input;
 }
 
+//! Time in seconds corresponding to the beginning of the year `year`.
+static double year_start_uncached(int year, const units::Unit &time_units,
+                                  const std::string &calendar) {
+  double result = 0.0;
+  int errcode = utInvCalendar2_cal(year,
+                                   1, 1, 0, 0, 0.0, // month, day, hour, minute, second
+                                   time_units.get(), &result,
+                                   calendar.c_str());
+  PISM_C_CHK(errcode, 0, "utInvCalendar2_cal");
+
+  return result;
+}
+
 /*!
 
   See http://meteora.ucsd.edu/~pierce/calcalcs/index.html and
@@ -59,7 +73,9 @@ Time_Calendar::Time_Calendar(MPI_Comm c, Config::ConstPtr conf,
                              const std::string &calendar_string,
                              units::System::Ptr units_system)
   : Time(conf, calendar_string, units_system),
-    m_com(c) {
+    m_com(c), m_calendar(NULL), m_first_year(0) {
+
+  reset_calendar_cache();
 
   std::string ref_date = m_config->get_string("reference_date");
 
@@ -76,14 +92,108 @@ Time_Calendar::Time_Calendar(MPI_Comm c, Config::ConstPtr conf,
     e.add_context("setting time units");
     throw;
   }
+  reset_calendar_cache();
 
   m_run_start = increment_date(0, (int)m_config->get_double("start_year"));
   m_run_end   = increment_date(m_run_start, (int)m_config->get_double("run_length_years"));
 
   m_time_in_seconds = m_run_start;
+
+  // pre-compute beginnings of years within the run
+  year_start(year(m_run_start));
+  year_start(year(m_run_end) + 1);
 }
 
 Time_Calendar::~Time_Calendar() {
+  ccs_free_calendar(m_calendar);
+}
+
+//! Re-initialize cached calendar data. Call this after changing the calendar or time units.
+void Time_Calendar::reset_calendar_cache() {
+  if (m_calendar != NULL) {
+    ccs_free_calendar(m_calendar);
+  }
+
+  m_calendar = ccs_init_calendar(m_calendar_string.c_str());
+  if (m_calendar == NULL) {
+    throw RuntimeError::formatted("calendar string '%s' is invalid", m_calendar_string.c_str());
+  }
+
+  m_year_start.clear();
+  m_first_year = 0;
+}
+
+//! Returns the year time `T` falls into.
+/*!
+ * Uses the table of beginnings of years if possible. Times close to
+ * the beginning of a year are affected by rounding in
+ * utCalendar2_cal(), so we call it in that case to get the same
+ * answer.
+ */
+int Time_Calendar::year(double T) const {
+  const int N = m_year_start.size();
+  const double margin = 3600.0; // seconds
+
+  if (N >= 2 and T >= m_year_start[0] and T < m_year_start[N - 1]) {
+    // guess assuming that all years have the same length, then correct
+    int k = (int)((T - m_year_start[0]) / (m_year_start[N - 1] - m_year_start[0]) * (N - 1));
+    k = std::max(0, std::min(k, N - 2));
+
+    while (T < m_year_start[k]) {
+      k -= 1;
+    }
+    while (T >= m_year_start[k + 1]) {
+      k += 1;
+    }
+
+    if (T - m_year_start[k] > margin and m_year_start[k + 1] - T > margin) {
+      return m_first_year + k;
+    }
+  }
+
+  int year, month, day, hour, minute;
+  double second;
+  utCalendar2_cal(T, m_time_units.get(),
+                  &year, &month, &day, &hour, &minute, &second,
+                  m_calendar_string.c_str());
+  return year;
+}
+
+//! Returns the time in seconds corresponding to the beginning of the year `Y`.
+/*!
+ * Extends the table of beginnings of years to include `Y` unless it
+ * is too far from years already in the table.
+ */
+double Time_Calendar::year_start(int Y) const {
+  const int
+    N       = m_year_start.size(),
+    max_gap = 10000;
+
+  if (N > 0 and Y >= m_first_year and Y < m_first_year + N) {
+    return m_year_start[Y - m_first_year];
+  }
+
+  if (N > 0 and (Y < m_first_year - max_gap or Y >= m_first_year + N + max_gap)) {
+    return year_start_uncached(Y, m_time_units, m_calendar_string);
+  }
+
+  if (N == 0) {
+    m_first_year = Y;
+    m_year_start.push_back(year_start_uncached(Y, m_time_units, m_calendar_string));
+  } else if (Y < m_first_year) {
+    std::vector<double> tmp;
+    for (int y = Y; y < m_first_year; ++y) {
+      tmp.push_back(year_start_uncached(y, m_time_units, m_calendar_string));
+    }
+    m_year_start.insert(m_year_start.begin(), tmp.begin(), tmp.end());
+    m_first_year = Y;
+  } else {
+    for (int y = m_first_year + N; y <= Y; ++y) {
+      m_year_start.push_back(year_start_uncached(y, m_time_units, m_calendar_string));
+    }
+  }
+
+  return m_year_start[Y - m_first_year];
 }
 
 bool Time_Calendar::process_ys(double &result) {
@@ -155,6 +265,7 @@ void Time_Calendar::init_from_input_file(const PIO &nc,
       std::string date_string = reference_date_from_file(nc, time_name);
       m_time_units = units::Unit(m_unit_system, "seconds " + date_string);
     }
+    reset_calendar_cache();
 
     // Read time information from the file. (PISM output files don't have time bounds, so we don't
     // bother checking for them.)
@@ -226,6 +337,7 @@ void Time_Calendar::init_from_file(const std::string &filename, const Logger &lo
       std::string date_string = reference_date_from_file(nc, time_name);
       m_time_units = units::Unit(m_unit_system, "seconds " + date_string);
     }
+    reset_calendar_cache();
 
     // Read time information from the file.
     std::vector<double> time;
@@ -264,28 +376,12 @@ double Time_Calendar::mod(double time, unsigned int) const {
 }
 
 double Time_Calendar::year_fraction(double T) const {
-  int year, month, day, hour, minute;
-  double second, year_start, next_year_start;
-
-  utCalendar2_cal(T, m_time_units.get(),
-                  &year, &month, &day, &hour, &minute, &second,
-                  m_calendar_string.c_str());
-
-  utInvCalendar2_cal(year,
-                     1, 1,            // month, day
-                     0, 0, 0,         // hour, minute, second
-                     m_time_units.get(),
-                     &year_start,
-                     m_calendar_string.c_str());
+  const int Y = year(T);
+  const double
+    start      = year_start(Y),
+    next_start = year_start(Y + 1);
 
-  utInvCalendar2_cal(year + 1,
-                     1, 1,           // month, day
-                     0, 0, 0,        // hour, minute, second
-                     m_time_units.get(),
-                     &next_year_start,
-                     m_calendar_string.c_str());
-
-  return (T - year_start) / (next_year_start - year_start);
+  return (T - start) / (next_start - start);
 }
 
 std::string Time_Calendar::date(double T) const {
@@ -315,22 +411,7 @@ std::string Time_Calendar::end_date() const {
 }
 
 double Time_Calendar::calendar_year_start(double T) const {
-  int year, month, day, hour, minute;
-  double second, result;
-
-  // Get the date corresponding to time T:
-  utCalendar2_cal(T, m_time_units.get(),
-                  &year, &month, &day, &hour, &minute, &second,
-                  m_calendar_string.c_str());
-
-  // Get the time in seconds corresponding to the beginning of the
-  // year.
-  utInvCalendar2_cal(year,
-                     1, 1, 0, 0, 0.0, // month, day, hour, minute, second
-                     m_time_units.get(), &result,
-                     m_calendar_string.c_str());
-
-  return result;
+  return year_start(year(T));
 }
 
 
@@ -344,13 +425,9 @@ double Time_Calendar::increment_date(double T, int years) const {
                   &year, &month, &day, &hour, &minute, &second,
                   m_calendar_string.c_str());
 
-  calcalcs_cal *cal = NULL;
   int errcode, leap = 0;
-  cal = ccs_init_calendar(m_calendar_string.c_str());
-  assert(cal != NULL);
-  errcode = ccs_isleap(cal, year + years, &leap);
+  errcode = ccs_isleap(m_calendar, year + years, &leap);
   assert(errcode == 0);
-  ccs_free_calendar(cal);
 
   if (leap == 0 && month == 2 && day == 29) {
     PetscErrorCode ierr = PetscPrintf(m_com,
@@ -435,14 +512,8 @@ void Time_Calendar::parse_date(const std::string &input, double *result) const {
     numbers[0] *= -1;
   }
 
-  calcalcs_cal *cal = ccs_init_calendar(m_calendar_string.c_str());
-  if (cal == NULL) {
-    throw RuntimeError::formatted("calendar string '%s' is invalid", m_calendar_string.c_str());
-  }
-
   int dummy = 0;
-  int errcode = ccs_date2jday(cal, numbers[0], numbers[1], numbers[2], &dummy);
-  ccs_free_calendar(cal);
+  int errcode = ccs_date2jday(m_calendar, numbers[0], numbers[1], numbers[2], &dummy);
   if (errcode != 0) {
     throw RuntimeError::formatted("date %s is invalid in the %s calendar",
                                   spec.c_str(), m_calendar_string.c_str());
@@ -540,11 +611,7 @@ void Time_Calendar::compute_times_yearly(std::vector<double> &result) const {
   while (true) {
     // find the time corresponding to the beginning of the current
     // year
-    errcode = utInvCalendar2_cal(year, 1, 1, // year, month, day
-                                 0, 0, 0.0,  // hour, minute, second
-                                 m_time_units.get(), &time,
-                                 m_calendar_string.c_str());
-    PISM_C_CHK(errcode, 0, "utInvCalendar2_cal");
+    time = year_start(year);
 
     if (time > m_run_end) {
       break;
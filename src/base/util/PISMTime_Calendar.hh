@@ -19,9 +19,14 @@
 #ifndef _PISMGREGORIANTIME_H_
 #define _PISMGREGORIANTIME_H_
 
+#include <vector>
+
 #include "PISMTime.hh"
 #include "PISMUnits.hh"
 
+// defined in calcalcs/calcalcs.h
+struct cccalendar;
+
 namespace pism {
 
 class Time_Calendar : public Time
@@ -91,7 +96,23 @@ protected:
 
   void compute_times_yearly(std::vector<double> &result) const;
 private:
+  void reset_calendar_cache();
+  int year(double T) const;
+  double year_start(int year) const;
+
   MPI_Comm m_com;
+
+  //! calendar object used to validate dates and check for leap years
+  cccalendar *m_calendar;
+
+  //! times of beginnings of years, starting from `m_first_year`
+  /*!
+   * Filled lazily: most queries fall within the run, so the table
+   * stays short. Has to be cleared when the calendar or time units
+   * change.
+   */
+  mutable std::vector<double> m_year_start;
+  mutable int m_first_year;
   // Hide copy constructor / assignment operator.
   Time_Calendar(Time_Calendar const &);
   Time_Calendar & operator=(Time_Calendar const &);
@@ -17,18 +17,475 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <cstdio>
+#include <sstream>
+#include <algorithm>
+
 #include "Profiling.hh"
 #include "error_handling.hh"
+#include "Logger.hh"
+#include "pism_const.hh"
 
 namespace pism {
 
 // PETSc profiling events
 
-Profiling::Profiling() {
+Profiling::Profiling()
+  : m_report_started(false), m_count_communication(false) {
   PetscErrorCode ierr = PetscClassIdRegister("PISM", &m_classid);
   PISM_CHK(ierr, "PetscClassIdRegister");
 }
 
+Profiling::Region::Region()
+  : time(0.0), count(0.0) {
+  // empty
+}
+
+Profiling::Communication::Communication()
+  : count(0.0), unchanged(0.0), bytes(0.0), time(0.0) {
+  // empty
+}
+
+//! Path of the innermost active region ("" if there is none).
+std::string Profiling::current_path() const {
+  return join(m_stack, "/");
+}
+
+//! Start the region `name` nested in regions that are currently active.
+void Profiling::region_begin(const char *name) const {
+  m_stack.push_back(name);
+  m_start.push_back(MPI_Wtime());
+
+  if (m_count_communication) {
+    set_reduction_region(current_path());
+  }
+}
+
+//! End the region `name` and regions nested in it that were not ended (because of an exception).
+void Profiling::region_end(const char *name) const {
+  // find the innermost active region with this name
+  std::vector<std::string>::reverse_iterator k = std::find(m_stack.rbegin(), m_stack.rend(),
+                                                           std::string(name));
+  if (k == m_stack.rend()) {
+    return;
+  }
+
+  const double now = MPI_Wtime();
+  const size_t N = m_stack.rend() - k - 1;
+
+  while (m_stack.size() > N) {
+    Region &r = m_regions[current_path()];
+    r.time  += now - m_start.back();
+    r.count += 1.0;
+
+    m_stack.pop_back();
+    m_start.pop_back();
+  }
+
+  if (m_count_communication) {
+    set_reduction_region(current_path());
+  }
+}
+
+//! Total time (on this processor) spent in regions called `name`, in seconds.
+/*!
+ * Includes all contexts `name` was used in, but only regions that
+ * ended. Not collective.
+ */
+double Profiling::time(const std::string &name) const {
+  double result = 0.0;
+
+  std::map<std::string, Region>::const_iterator k;
+  for (k = m_regions.begin(); k != m_regions.end(); ++k) {
+    const std::string &path = k->first;
+    const size_t n = name.size();
+
+    if (path.size() >= n and path.compare(path.size() - n, n, name) == 0 and
+        (path.size() == n or path[path.size() - n - 1] == '/')) {
+      result += k->second.time;
+    }
+  }
+
+  return result;
+}
+
+//! Turn counting of ghost updates and global reductions on or off.
+/*!
+ * Off by default, so that runs that do not write a profiling report
+ * do not pay for the bookkeeping.
+ */
+void Profiling::set_communication_counting(bool flag) const {
+  m_count_communication = flag;
+  set_reduction_counting(flag);
+  set_reduction_region(current_path());
+}
+
+//! True if communication() records anything (see set_communication_counting()).
+bool Profiling::communication_counting() const {
+  return m_count_communication;
+}
+
+/*!
+ * Record a communication operation involving `field` in the current region.
+ *
+ * @param[in] operation name of the operation ("update_ghosts", ...)
+ * @param[in] field name of the field
+ * @param[in] bytes number of bytes received by this processor
+ * @param[in] time time spent waiting for the operation to complete, in seconds
+ * @param[in] unchanged true if the update was skipped because the field did
+ *                      not change since the last one
+ */
+void Profiling::communication(const char *operation, const std::string &field,
+                              double bytes, double time, bool unchanged) const {
+  if (not m_count_communication) {
+    return;
+  }
+
+  Communication &c = m_communication[current_path() + "\t" + operation + "\t" + field];
+  c.count     += 1.0;
+  c.unchanged += unchanged ? 1.0 : 0.0;
+  c.bytes     += bytes;
+  c.time      += time;
+}
+
+static std::string json_escape(const std::string &input) {
+  std::string result;
+  for (size_t k = 0; k < input.size(); ++k) {
+    if (input[k] == '"' or input[k] == '\\') {
+      result += '\\';
+    }
+    result += input[k];
+  }
+  return result;
+}
+
+//! Argument of MPI_MAXLOC reductions (corresponds to MPI_DOUBLE_INT).
+struct DoubleInt {
+  double value;
+  int rank;
+};
+
+//! Broadcast a list of names (without newlines) from processor 0.
+static void broadcast_names(MPI_Comm com, std::vector<std::string> &names) {
+  int rank = 0;
+  MPI_Comm_rank(com, &rank);
+
+  std::string buffer;
+  if (rank == 0) {
+    for (size_t k = 0; k < names.size(); ++k) {
+      buffer += names[k] + "\n";
+    }
+  }
+
+  int length = buffer.size();
+  MPI_Bcast(&length, 1, MPI_INT, 0, com);
+  std::vector<char> tmp(length + 1, '\0');
+  if (rank == 0) {
+    std::copy(buffer.begin(), buffer.end(), tmp.begin());
+  }
+  MPI_Bcast(&tmp[0], length, MPI_CHAR, 0, com);
+
+  names.clear();
+  std::istringstream input(std::string(&tmp[0], length));
+  std::string name;
+  while (std::getline(input, name)) {
+    names.push_back(name);
+  }
+}
+
+/*!
+ * Communication statistics (collective).
+ *
+ * Returns (on processor 0) a comma-separated list of JSON objects, one
+ * per region, operation and field (empty for global reductions), with
+ * the number of calls and of skipped ghost updates of unchanged fields
+ * (maximum over processors), the number of bytes (sum over
+ * processors) and the minimum, average and maximum time.
+ */
+std::string Profiling::communication_report(MPI_Comm com) const {
+  int rank = 0, size = 1;
+  MPI_Comm_rank(com, &rank);
+  MPI_Comm_size(com, &size);
+
+  // combine ghost updates recorded here with global reductions
+  // recorded by GlobalReduce()
+  std::map<std::string, Communication> counters = m_communication;
+  {
+    const ReductionCounters &reductions = reduction_counters();
+    ReductionCounters::const_iterator j;
+    for (j = reductions.begin(); j != reductions.end(); ++j) {
+      Communication &c = counters[j->first + "\t"];
+      c.count = j->second.count;
+      c.bytes = j->second.bytes;
+      c.time  = j->second.time;
+    }
+  }
+
+  std::vector<std::string> names;
+  if (rank == 0) {
+    std::map<std::string, Communication>::const_iterator j;
+    for (j = counters.begin(); j != counters.end(); ++j) {
+      names.push_back(j->first);
+    }
+  }
+  broadcast_names(com, names);
+
+  const int N = names.size();
+  if (N == 0) {
+    return "";
+  }
+
+  std::vector<double> count(N, 0.0), unchanged(N, 0.0), bytes(N, 0.0), time(N, 0.0);
+  for (int k = 0; k < N; ++k) {
+    std::map<std::string, Communication>::const_iterator c = counters.find(names[k]);
+    if (c != counters.end()) {
+      count[k]     = c->second.count;
+      unchanged[k] = c->second.unchanged;
+      bytes[k]     = c->second.bytes;
+      time[k]      = c->second.time;
+    }
+  }
+
+  std::vector<double> count_max(N), unchanged_max(N), bytes_sum(N),
+    time_min(N), time_max(N), time_sum(N);
+  MPI_Reduce(&count[0], &count_max[0], N, MPI_DOUBLE, MPI_MAX, 0, com);
+  MPI_Reduce(&unchanged[0], &unchanged_max[0], N, MPI_DOUBLE, MPI_MAX, 0, com);
+  MPI_Reduce(&bytes[0], &bytes_sum[0], N, MPI_DOUBLE, MPI_SUM, 0, com);
+  MPI_Reduce(&time[0], &time_min[0], N, MPI_DOUBLE, MPI_MIN, 0, com);
+  MPI_Reduce(&time[0], &time_max[0], N, MPI_DOUBLE, MPI_MAX, 0, com);
+  MPI_Reduce(&time[0], &time_sum[0], N, MPI_DOUBLE, MPI_SUM, 0, com);
+
+  if (rank != 0) {
+    return "";
+  }
+
+  std::string result;
+  for (int k = 0; k < N; ++k) {
+    // region, operation, field
+    std::vector<std::string> key = split(names[k], '\t');
+    key.resize(3);
+
+    char buffer[TEMPORARY_STRING_LENGTH];
+    snprintf(buffer, sizeof(buffer),
+             "%s{\"region\": \"%s\", \"operation\": \"%s\", \"field\": \"%s\","
+             " \"count\": %.0f, \"unchanged\": %.0f, \"bytes\": %.0f,"
+             " \"min\": %.6f, \"avg\": %.6f, \"max\": %.6f}",
+             k > 0 ? ", " : "",
+             json_escape(key[0]).c_str(), json_escape(key[1]).c_str(),
+             json_escape(key[2]).c_str(),
+             count_max[k], unchanged_max[k], bytes_sum[k],
+             time_min[k], time_sum[k] / size, time_max[k]);
+    result += buffer;
+  }
+
+  return result;
+}
+
+//! \brief Append per-region timing statistics to `filename` (collective).
+/*!
+ * Writes one line in the JSON format per call. The first call in a run
+ * truncates the file. Each line contains `label` (for example the
+ * model date) and for each region the number of calls, minimum,
+ * average and maximum (over processors) total time in seconds since
+ * the beginning of the run, and the imbalance ratio max/avg, followed
+ * by communication statistics (see communication_report()).
+ *
+ * Uses the list of regions known to processor 0.
+ */
+void Profiling::report(MPI_Comm com, const std::string &filename,
+                       const std::string &label) const {
+  int rank = 0, size = 1;
+  MPI_Comm_rank(com, &rank);
+  MPI_Comm_size(com, &size);
+
+  // use the list of region paths known to processor 0
+  std::vector<std::string> names;
+  if (rank == 0) {
+    std::map<std::string, Region>::const_iterator j;
+    for (j = m_regions.begin(); j != m_regions.end(); ++j) {
+      names.push_back(j->first);
+    }
+  }
+  broadcast_names(com, names);
+
+  const int N = names.size();
+  if (N == 0) {
+    return;
+  }
+
+  // open the file before the reductions below so that all processors
+  // can stop if processor 0 fails to open it
+  FILE *f = NULL;
+  int file_ok = 1;
+  if (rank == 0) {
+    f = fopen(filename.c_str(), m_report_started ? "a" : "w");
+    file_ok = f != NULL;
+  }
+  MPI_Bcast(&file_ok, 1, MPI_INT, 0, com);
+
+  if (not file_ok) {
+    throw RuntimeError::formatted("cannot open '%s' to write the profiling report",
+                                  filename.c_str());
+  }
+
+  std::vector<double> time(N, 0.0), count(N, 0.0);
+  for (int k = 0; k < N; ++k) {
+    std::map<std::string, Region>::const_iterator r = m_regions.find(names[k]);
+    if (r != m_regions.end()) {
+      time[k]  = r->second.time;
+      count[k] = r->second.count;
+    }
+  }
+
+  std::vector<double> time_min(N), time_max(N), time_sum(N), count_max(N);
+  MPI_Reduce(&time[0], &time_min[0], N, MPI_DOUBLE, MPI_MIN, 0, com);
+  MPI_Reduce(&time[0], &time_max[0], N, MPI_DOUBLE, MPI_MAX, 0, com);
+  MPI_Reduce(&time[0], &time_sum[0], N, MPI_DOUBLE, MPI_SUM, 0, com);
+  MPI_Reduce(&count[0], &count_max[0], N, MPI_DOUBLE, MPI_MAX, 0, com);
+
+  const std::string communication = communication_report(com);
+
+  if (rank != 0) {
+    return;
+  }
+
+  m_report_started = true;
+
+  fprintf(f, "{\"label\": \"%s\", \"processors\": %d, \"regions\": [",
+          json_escape(label).c_str(), size);
+  for (int k = 0; k < N; ++k) {
+    const double time_avg = time_sum[k] / size;
+
+    fprintf(f, "%s{\"name\": \"%s\", \"count\": %.0f, \"min\": %.6f, \"avg\": %.6f,"
+            " \"max\": %.6f, \"imbalance\": %.3f}",
+            k > 0 ? ", " : "",
+            json_escape(names[k]).c_str(), count_max[k],
+            time_min[k], time_avg, time_max[k],
+            time_avg > 0.0 ? time_max[k] / time_avg : 1.0);
+  }
+  fprintf(f, "], \"communication\": [%s]}\n", communication.c_str());
+  fclose(f);
+}
+
+Profiling::MemoryUsage::MemoryUsage()
+  : current(0.0), peak(0.0) {
+  // empty
+}
+
+//! Start tagging allocations with the name `component` (until memory_scope_end()).
+void Profiling::memory_scope_begin(const char *component) const {
+  m_memory_scopes.push_back(component);
+}
+
+//! End the innermost memory scope `component` and scopes nested in it.
+void Profiling::memory_scope_end(const char *component) const {
+  std::vector<std::string>::reverse_iterator k = std::find(m_memory_scopes.rbegin(),
+                                                           m_memory_scopes.rend(),
+                                                           std::string(component));
+  if (k != m_memory_scopes.rend()) {
+    m_memory_scopes.resize(m_memory_scopes.rend() - k - 1);
+  }
+}
+
+MemoryScope::MemoryScope(const Profiling &profiling, const char *component)
+  : m_profiling(profiling), m_component(component) {
+  m_profiling.memory_scope_begin(component);
+}
+
+MemoryScope::~MemoryScope() {
+  m_profiling.memory_scope_end(m_component.c_str());
+}
+
+//! Name of the component new allocations should be attributed to.
+std::string Profiling::memory_component() const {
+  if (m_memory_scopes.empty()) {
+    return "other";
+  }
+  return m_memory_scopes.back();
+}
+
+//! Record an allocation of `bytes` bytes (on this processor) by `component`.
+void Profiling::memory_allocated(const std::string &component, double bytes) const {
+  MemoryUsage &m = m_memory[component];
+  m.current += bytes;
+  m.peak     = std::max(m.peak, m.current);
+
+  m_memory_total.current += bytes;
+  m_memory_total.peak     = std::max(m_memory_total.peak, m_memory_total.current);
+}
+
+//! Record de-allocation of `bytes` bytes (on this processor) by `component`.
+void Profiling::memory_freed(const std::string &component, double bytes) const {
+  MemoryUsage &m = m_memory[component];
+  m.current = std::max(m.current - bytes, 0.0);
+
+  m_memory_total.current = std::max(m_memory_total.current - bytes, 0.0);
+}
+
+/*!
+ * Print a summary of memory usage per component (collective).
+ *
+ * For each component prints the current total (sum over processors),
+ * the current and peak maximum over processors (in MiB) and the
+ * processor with the highest peak.
+ *
+ * Uses the list of components known to processor 0.
+ */
+void Profiling::memory_report(MPI_Comm com, const Logger &log, int threshold) const {
+  int rank = 0;
+  MPI_Comm_rank(com, &rank);
+
+  std::vector<std::string> names;
+  if (rank == 0) {
+    std::map<std::string, MemoryUsage>::const_iterator j;
+    for (j = m_memory.begin(); j != m_memory.end(); ++j) {
+      names.push_back(j->first);
+    }
+  }
+  broadcast_names(com, names);
+
+  // the last entry is the total over all components
+  const int N = names.size() + 1;
+
+  std::vector<DoubleInt> current(N), peak(N), current_max(N), peak_max(N);
+  std::vector<double> current_local(N, 0.0), current_sum(N, 0.0);
+
+  for (int k = 0; k < N; ++k) {
+    MemoryUsage m = m_memory_total;
+    if (k < N - 1) {
+      std::map<std::string, MemoryUsage>::const_iterator j = m_memory.find(names[k]);
+      m = j != m_memory.end() ? j->second : MemoryUsage();
+    }
+
+    current[k].value = m.current;
+    current[k].rank  = rank;
+    peak[k].value    = m.peak;
+    peak[k].rank     = rank;
+    current_local[k] = m.current;
+  }
+
+  MPI_Reduce(&current_local[0], &current_sum[0], N, MPI_DOUBLE, MPI_SUM, 0, com);
+  MPI_Reduce(&current[0], &current_max[0], N, MPI_DOUBLE_INT, MPI_MAXLOC, 0, com);
+  MPI_Reduce(&peak[0], &peak_max[0], N, MPI_DOUBLE_INT, MPI_MAXLOC, 0, com);
+
+  if (rank != 0) {
+    return;
+  }
+
+  const double MiB = 1024.0 * 1024.0;
+
+  log.message(threshold,
+              "Memory usage (MiB):\n"
+              "  %-28s %10s %10s %10s %5s\n",
+              "component", "total", "max/proc", "peak/proc", "proc");
+  for (int k = 0; k < N; ++k) {
+    log.message(threshold, "  %-28s %10.1f %10.1f %10.1f %5d\n",
+                k < N - 1 ? names[k].c_str() : "total",
+                current_sum[k] / MiB, current_max[k].value / MiB,
+                peak_max[k].value / MiB, peak_max[k].rank);
+  }
+}
+
 void Profiling::begin(const char * name) const {
   PetscLogEvent event = 0;
   PetscErrorCode ierr;
@@ -43,9 +500,13 @@ void Profiling::begin(const char * name) const {
   }
   ierr = PetscLogEventBegin(event, 0, 0, 0, 0);
   PISM_CHK(ierr, "PetscLogEventBegin");
+
+  region_begin(name);
 }
 
 void Profiling::end(const char * name) const {
+  region_end(name);
+
   PetscLogEvent event = 0;
   if (m_events.find(name) == m_events.end()) {
     throw RuntimeError::formatted("cannot end event \"%s\" because it was not started",
@@ -71,10 +532,13 @@ void Profiling::stage_begin(const char * name) const {
   }
   ierr = PetscLogStagePush(stage);
   PISM_CHK(ierr, "PetscLogStagePush");
+
+  region_begin(name);
 }
 
 void Profiling::stage_end(const char * name) const {
-  (void) name;
+  region_end(name);
+
   PetscErrorCode ierr = PetscLogStagePop();
   PISM_CHK(ierr, "PetscLogStagePop");
 }
@@ -22,10 +22,31 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include <petsclog.h>
 
 namespace pism {
 
+class Logger;
+
+//! \brief Wrapper around PETSc's profiling events and stages.
+/*!
+ * In addition to PETSc events this records the wall-clock time and the
+ * number of calls for each *region*. Regions are identified by paths
+ * of nested events and stages ("time-stepping loop/stress balance"),
+ * so the same event started in different contexts is recorded
+ * separately. See report().
+ *
+ * Also keeps track of memory used by IceModelVecs (and other large
+ * allocations) per *component*: allocations are tagged with the name
+ * of the innermost active memory scope (see MemoryScope), or
+ * "other" if there is none. Peaks are per processor. See
+ * memory_report().
+ *
+ * Ghost updates (per field) and global reductions (see GlobalSum())
+ * are counted per region and included in report() if enabled using
+ * set_communication_counting().
+ */
 class Profiling {
 public:
   Profiling();
@@ -33,10 +54,84 @@ public:
   void end(const char *name) const;
   void stage_begin(const char *name) const;
   void stage_end(const char *name) const;
+
+  void report(MPI_Comm com, const std::string &filename, const std::string &label) const;
+  double time(const std::string &name) const;
+
+  void memory_scope_begin(const char *component) const;
+  void memory_scope_end(const char *component) const;
+  std::string memory_component() const;
+
+  void memory_allocated(const std::string &component, double bytes) const;
+  void memory_freed(const std::string &component, double bytes) const;
+
+  void memory_report(MPI_Comm com, const Logger &log, int threshold) const;
+
+  void set_communication_counting(bool flag) const;
+  bool communication_counting() const;
+  void communication(const char *operation, const std::string &field,
+                     double bytes, double time, bool unchanged) const;
 private:
+  void region_begin(const char *name) const;
+  void region_end(const char *name) const;
+  std::string current_path() const;
+  std::string communication_report(MPI_Comm com) const;
+
   PetscClassId m_classid;
   mutable std::map<std::string, PetscLogEvent> m_events;
   mutable std::map<std::string, PetscLogStage> m_stages;
+
+  struct Region {
+    Region();
+    double time;                //!< total wall-clock time, in seconds
+    double count;               //!< number of calls
+  };
+  //! regions, indexed by path
+  mutable std::map<std::string, Region> m_regions;
+  //! names and start times of regions that are currently active
+  mutable std::vector<std::string> m_stack;
+  mutable std::vector<double> m_start;
+  //! true if report() wrote to its file already
+  mutable bool m_report_started;
+
+  struct Communication {
+    Communication();
+    double count;               //!< number of calls
+    double unchanged;           //!< number of ghost updates skipped because fields did not change
+    double bytes;               //!< bytes received (ghost updates) or reduced (on this processor)
+    double time;                //!< total wall-clock time, in seconds
+  };
+  //! communication counters, indexed by "region<TAB>operation<TAB>field"
+  mutable std::map<std::string, Communication> m_communication;
+  //! true if communication() and GlobalReduce() should record anything
+  mutable bool m_count_communication;
+
+  struct MemoryUsage {
+    MemoryUsage();
+    double current;             //!< bytes currently allocated
+    double peak;                //!< maximum of `current` since the beginning of the run
+  };
+  //! memory usage (on this processor), indexed by component name
+  mutable std::map<std::string, MemoryUsage> m_memory;
+  //! memory usage (on this processor), all components
+  mutable MemoryUsage m_memory_total;
+  //! names of memory scopes that are currently active
+  mutable std::vector<std::string> m_memory_scopes;
+};
+
+//! \brief Memory scope (see Profiling::memory_scope_begin()) that ends
+//! when this object goes out of scope, even if an exception is thrown.
+class MemoryScope {
+public:
+  MemoryScope(const Profiling &profiling, const char *component);
+  ~MemoryScope();
+private:
+  const Profiling &m_profiling;
+  std::string m_component;
+
+  // Hide copy constructor / assignment operator.
+  MemoryScope(const MemoryScope &);
+  MemoryScope & operator=(const MemoryScope &);
 };
 
 } // end of namespace pism
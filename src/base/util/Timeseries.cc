@@ -55,6 +55,7 @@ void Timeseries::private_constructor(MPI_Comm c, const std::string &name, const
 
   short_name = name;
   m_use_bounds = true;
+  m_cursor = 0;
 }
 
 //! Ensure that time bounds have the same units as the dimension.
@@ -186,6 +187,41 @@ void Timeseries::scale(double scaling_factor) {
   }
 }
 
+//! Find the index of the first element of `x` that is not less than `t`.
+/*!
+ * Returns the same as `std::lower_bound()`, but checks the interval found
+ * during the previous call and the two following it before falling back
+ * to a binary search. This makes evaluating a time-series at increasing
+ * times O(1) per call.
+ *
+ * @param[in] x sorted array
+ * @param[in] t value to look up
+ */
+size_t Timeseries::find(const std::vector<double> &x, double t) {
+  const size_t n = x.size();
+
+  if (n > 0) {
+    if (m_cursor == 0 and t <= x[0]) {
+      return 0;
+    }
+
+    if (m_cursor == n and x[n - 1] < t) {
+      return n;
+    }
+
+    for (size_t k = std::max(m_cursor, (size_t)1); k < m_cursor + 3 and k < n; ++k) {
+      if (x[k - 1] < t and t <= x[k]) {
+        m_cursor = k;
+        return k;
+      }
+    }
+  }
+
+  m_cursor = lower_bound(x.begin(), x.end(), t) - x.begin(); // binary search
+
+  return m_cursor;
+}
+
 //! Get a value of timeseries at time `t`.
 /*! Returns the first value or the last value if t is out of range on the left
   and right, respectively.
@@ -197,15 +233,13 @@ double Timeseries::operator()(double t) {
 
   // piecewise-constant case:
   if (m_use_bounds) {
-    std::vector<double>::iterator j;
+    const size_t j = find(m_time_bounds, t);
 
-    j = lower_bound(m_time_bounds.begin(), m_time_bounds.end(), t); // binary search
-
-    if (j == m_time_bounds.end()) {
+    if (j == m_time_bounds.size()) {
       return m_values.back(); // out of range (on the right)
     }
 
-    int i = (int)(j - m_time_bounds.begin());
+    int i = (int)j;
 
     if (i == 0) {
       return m_values[0];         // out of range (on the left)
@@ -221,15 +255,13 @@ double Timeseries::operator()(double t) {
   }
 
   // piecewise-linear case:
-  std::vector<double>::iterator end = m_time.end(), j;
-  
-  j = lower_bound(m_time.begin(), end, t); // binary search
+  const size_t j = find(m_time, t);
 
-  if (j == end) {
+  if (j == m_time.size()) {
     return m_values.back(); // out of range (on the right)
   }
 
-  int i = (int)(j - m_time.begin());
+  int i = (int)j;
 
   if (i == 0) {
     return m_values[0];   // out of range (on the left)
@@ -241,6 +273,17 @@ double Timeseries::operator()(double t) {
   return m_values[i - 1] + (t - m_time[i - 1]) / dt * dv;
 }
 
+//! Get values of timeseries at times `times` (see operator()).
+/*!
+ * Faster if `times` are increasing.
+ */
+void Timeseries::evaluate(const std::vector<double> &times, std::vector<double> &values) {
+  values.resize(times.size());
+  for (unsigned int k = 0; k < times.size(); ++k) {
+    values[k] = (*this)(times[k]);
+  }
+}
+
 //! Get a value of timeseries by index.
 /*!
   Stops if the index is out of range.
@@ -260,13 +303,14 @@ double Timeseries::operator[](unsigned int j) const {
 //! \brief Compute an average of a time-series over interval (t,t+dt) using
 //! trapezoidal rule with N sub-intervals.
 double Timeseries::average(double t, double dt, unsigned int N) {
-  std::vector<double> V(N+1);
- 
+  std::vector<double> T(N+1), V;
+
   for (unsigned int i = 0; i < N+1; ++i) {
-    double t_i = t + (dt / N) * i;
-    V[i] = (*this)(t_i);
+    T[i] = t + (dt / N) * i;
   }
 
+  evaluate(T, V);
+
   double sum = 0;
   for (unsigned int i = 0; i < N; ++i) {
     sum += V[i] + V[i+1];
@@ -70,6 +70,10 @@ class Logger;
   \code
   double offset = (*delta_T)[10];
   \endcode
+
+  The interval containing the last requested time is remembered, so a
+  sequence of requests with increasing times costs O(1) per request instead
+  of a binary search. Use evaluate() to get values at many times at once.
 */
 class Timeseries {
 public:
@@ -80,6 +84,7 @@ public:
   void read(const PIO &nc, const Time &time_manager, const Logger &log);
   void write(const PIO &nc);
   double operator()(double time);
+  void evaluate(const std::vector<double> &times, std::vector<double> &values);
   double operator[](unsigned int j) const;
   double average(double t, double dt, unsigned int N);
   void append(double value, double a, double b);
@@ -101,6 +106,10 @@ protected:
   std::vector<double> m_values;
   std::vector<double> m_time_bounds;
 private:
+  //! index returned by the last call of find() (a hint; any value is safe)
+  size_t m_cursor;
+  size_t find(const std::vector<double> &x, double t);
+
   void private_constructor(MPI_Comm com, const std::string &name, const std::string &dimension_name);
   void report_range(const Logger &log);
 };
@@ -191,4 +191,23 @@ void ParallelSection::check() {
   }
 }
 
+//! @brief Same as check(), but also returns true if `flag` is true on
+//! at least one processor.
+/*!
+ * Uses one reduction for both, so a parallel section can compute a
+ * collective flag (for example "the field changed") at no extra cost.
+ */
+bool ParallelSection::check(bool flag) {
+  int local[2] = {m_failed ? 1 : 0, flag ? 1 : 0};
+  int global[2] = {0, 0};
+
+  MPI_Allreduce(local, global, 2, MPI_INT, MPI_MAX, m_com);
+
+  if (global[0] != 0) {
+    throw RuntimeError("Failure in a parallel section. See error messages above for more.");
+  }
+
+  return global[1] != 0;
+}
+
 } // end of namespace pism
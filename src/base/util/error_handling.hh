@@ -49,6 +49,7 @@ public:
   ParallelSection(MPI_Comm com);
   ~ParallelSection();
   void check();
+  bool check(bool flag);
   void failed();
   void reset();
 private:
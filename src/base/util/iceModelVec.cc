@@ -29,6 +29,8 @@
 #include "iceModelVec_helpers.hh"
 #include "io/io_helpers.hh"
 #include "base/util/Logger.hh"
+#include "base/util/Context.hh"
+#include "base/util/Profiling.hh"
 
 namespace pism {
 
@@ -51,6 +53,12 @@ IceModelVec::IceModelVec() {
   reset_attrs(0);
 
   m_state_counter = 0;
+  m_ghost_update_in_progress = false;
+  m_ghosts_state_counter = -1;
+  m_write_access = false;
+  m_ghost_update_time = 0.0;
+
+  m_memory_bytes = 0.0;
 
   zlevels.resize(1);
   zlevels[0] = 0.0;
@@ -97,6 +105,45 @@ void IceModelVec::inc_state_counter() {
 
 IceModelVec::~IceModelVec() {
   assert(m_access_counter == 0);
+  assert(m_ghost_update_in_progress == false);
+
+  if (m_memory_bytes > 0.0) {
+    m_grid->ctx()->profiling().memory_freed(m_memory_component, m_memory_bytes);
+  }
+}
+
+//! \brief Record memory used by `v` (allocated by this IceModelVec).
+/*!
+ * Storage is attributed to the component that is active (see
+ * Profiling::memory_scope_begin()) when the first Vec is allocated.
+ * Memory is released in the destructor.
+ */
+void IceModelVec::track_memory(Vec v) {
+  PetscInt size = 0;
+  PetscErrorCode ierr = VecGetLocalSize(v, &size);
+  PISM_CHK(ierr, "VecGetLocalSize");
+
+  const Profiling &profiling = m_grid->ctx()->profiling();
+
+  if (m_memory_bytes == 0.0) {
+    m_memory_component = profiling.memory_component();
+  }
+
+  const double bytes = size * sizeof(PetscScalar);
+  profiling.memory_allocated(m_memory_component, bytes);
+  m_memory_bytes += bytes;
+}
+
+//! \brief Number of bytes in ghost points of a local Vec `v` (storage
+//! for values this processor receives during a ghost update).
+double IceModelVec::ghost_bytes(Vec v) const {
+  PetscInt size = 0;
+  PetscErrorCode ierr = VecGetLocalSize(v, &size);
+  PISM_CHK(ierr, "VecGetLocalSize");
+
+  const double owned = m_grid->xm() * m_grid->ym() * m_dof * zlevels.size();
+
+  return (size - owned) * sizeof(PetscScalar);
 }
 
 //! Returns true if create() was called and false otherwise.
@@ -192,6 +239,8 @@ void IceModelVec::squareroot() {
 
   PetscErrorCode ierr = VecSqrtAbs(m_v);
   PISM_CHK(ierr, "VecSqrtAbs");
+
+  inc_state_counter();          // mark as modified
 }
 
 
@@ -344,7 +393,10 @@ unsigned int IceModelVec::get_stencil_width() const {
   }
 }
 
+//! Returns the PETSc Vec. The caller may modify it, so ghosts are
+//! considered out of date.
 Vec IceModelVec::get_vec() {
+  m_ghosts_state_counter = -1;
   return m_v;
 }
 
@@ -607,40 +659,142 @@ void  IceModelVec::end_access() const {
       PISM_CHK(ierr, "DMDAVecRestoreArray");
     }
     array = NULL;
+
+    if (m_write_access) {
+      // values may have changed: the next update_ghosts() call has to communicate
+      m_ghosts_state_counter = -1;
+      m_write_access = false;
+    }
   }
 }
 
+//! \brief Returns true if ghosts are known to be up to date, i.e. the
+//! field was not modified since the last ghost update.
+/*!
+ * A field is considered modified if its state counter changed, if it
+ * was added to an AccessList as a non-const IceModelVec or if
+ * get_vec() or get_array() was called.
+ *
+ * All of these are collective (the same on all processors), so all
+ * processors make the same decision.
+ */
+bool IceModelVec::ghosts_are_current() const {
+  return (not m_write_access and
+          m_ghosts_state_counter == m_state_counter);
+}
+
+//! Record the fact that ghosts were just updated.
+void IceModelVec::ghosts_updated() const {
+  m_ghosts_state_counter = m_state_counter;
+}
+
 //! Updates ghost points.
+/*!
+ * Does nothing if this field was not modified since the last ghost
+ * update (see ghosts_are_current()).
+ *
+ * Code modifying a field without using IceModelVec methods, an
+ * AccessList or get_vec() (for example by calling begin_access() and
+ * end_access() directly) has to call inc_state_counter().
+ */
 void  IceModelVec::update_ghosts() {
-  PetscErrorCode ierr;
+  update_ghosts_begin();
+  update_ghosts_end();
+}
+
+//! Starts updating ghost points.
+/*!
+ * Values at points owned by this processor may be read (but not
+ * modified) until update_ghosts_end() is called. Ghost values are not
+ * valid until then. This makes it possible to do computations that do
+ * not need ghosts (see InteriorPoints) while messages are in flight:
+ *
+ * @code
+ * foo.update_ghosts_begin();
+ * for (InteriorPoints p(grid, 1); p; p.next()) {
+ *   // use foo at (i,j) and its neighbors
+ * }
+ * foo.update_ghosts_end();
+ * for (RimPoints p(grid, 1); p; p.next()) {
+ *   // same here
+ * }
+ * @endcode
+ */
+void IceModelVec::update_ghosts_begin() {
   if (m_has_ghosts == false) {
     return;
   }
 
   assert(m_v != NULL);
+  assert(m_ghost_update_in_progress == false);
+
+  if (ghosts_are_current()) {
+    const Profiling &profiling = m_grid->ctx()->profiling();
+    if (profiling.communication_counting()) {
+      profiling.communication("update_ghosts", m_name, 0.0, 0.0, true);
+    }
+    return;
+  }
+
+  const double start = MPI_Wtime();
+
+  PetscErrorCode ierr;
 #if PETSC_VERSION_LT(3,5,0)
   ierr = DMDALocalToLocalBegin(*m_da, m_v, INSERT_VALUES, m_v);
   PISM_CHK(ierr, "DMDALocalToLocalBegin");
+#else
+  ierr = DMLocalToLocalBegin(*m_da, m_v, INSERT_VALUES, m_v);
+  PISM_CHK(ierr, "DMLocalToLocalBegin");
+#endif
 
+  m_ghost_update_time = MPI_Wtime() - start;
+  m_ghost_update_in_progress = true;
+}
+
+//! Finishes updating ghost points. Does nothing if no update is in progress.
+void IceModelVec::update_ghosts_end() {
+  if (m_ghost_update_in_progress == false) {
+    return;
+  }
+
+  const double start = MPI_Wtime();
+
+  PetscErrorCode ierr;
+#if PETSC_VERSION_LT(3,5,0)
   ierr = DMDALocalToLocalEnd(*m_da, m_v, INSERT_VALUES, m_v);
   PISM_CHK(ierr, "DMDALocalToLocalEnd");
 #else
-  ierr = DMLocalToLocalBegin(*m_da, m_v, INSERT_VALUES, m_v);
-  PISM_CHK(ierr, "DMLocalToLocalBegin");
-  
   ierr = DMLocalToLocalEnd(*m_da, m_v, INSERT_VALUES, m_v);
   PISM_CHK(ierr, "DMLocalToLocalEnd");
 #endif
+
+  m_ghost_update_time += MPI_Wtime() - start;
+  m_ghost_update_in_progress = false;
+
+  const Profiling &profiling = m_grid->ctx()->profiling();
+  if (profiling.communication_counting()) {
+    profiling.communication("update_ghosts", m_name, ghost_bytes(m_v),
+                            m_ghost_update_time, false);
+  }
+  ghosts_updated();
 }
 
 void IceModelVec::global_to_local(petsc::DM::Ptr dm, Vec source, Vec destination) const {
   PetscErrorCode ierr;
 
+  const double start = MPI_Wtime();
+
   ierr = DMGlobalToLocalBegin(*dm, source, INSERT_VALUES, destination);
   PISM_CHK(ierr, "DMGlobalToLocalBegin");
 
   ierr = DMGlobalToLocalEnd(*dm, source, INSERT_VALUES, destination);
   PISM_CHK(ierr, "DMGlobalToLocalEnd");
+
+  const Profiling &profiling = m_grid->ctx()->profiling();
+  if (profiling.communication_counting()) {
+    profiling.communication("global_to_local", m_name, ghost_bytes(destination),
+                            MPI_Wtime() - start, false);
+  }
 }
 
 
@@ -654,6 +808,7 @@ void  IceModelVec::update_ghosts(IceModelVec &destination) const {
   assert(destination.m_has_ghosts == true);
 
   if (m_has_ghosts == true && destination.m_has_ghosts == true) {
+    const double start = MPI_Wtime();
 #if PETSC_VERSION_LT(3,5,0)
     ierr = DMDALocalToLocalBegin(*m_da, m_v, INSERT_VALUES, destination.m_v);
     PISM_CHK(ierr, "DMDALocalToLocalBegin");
@@ -667,15 +822,19 @@ void  IceModelVec::update_ghosts(IceModelVec &destination) const {
     ierr = DMLocalToLocalEnd(*m_da, m_v, INSERT_VALUES, destination.m_v);
     PISM_CHK(ierr, "DMLocalToLocalEnd");
 #endif
-    return;
-  }
-
-  if (m_has_ghosts == false && destination.m_has_ghosts == true) {
+    const Profiling &profiling = m_grid->ctx()->profiling();
+    if (profiling.communication_counting()) {
+      profiling.communication("update_ghosts", destination.m_name,
+                              ghost_bytes(destination.m_v),
+                              MPI_Wtime() - start, false);
+    }
+  } else if (m_has_ghosts == false && destination.m_has_ghosts == true) {
     global_to_local(destination.m_da, m_v, destination.m_v);
-    return;
   }
 
   destination.inc_state_counter();          // mark as modified
+  // both owned values and ghosts of destination were set
+  destination.ghosts_updated();
 }
 
 //! Result: v[j] <- c for all j.
@@ -915,11 +1074,22 @@ IceModelVec::AccessList::AccessList(const IceModelVec &vec) {
   add(vec);
 }
 
+IceModelVec::AccessList::AccessList(IceModelVec &vec) {
+  add(vec);
+}
+
 void IceModelVec::AccessList::add(const IceModelVec &vec) {
   vec.begin_access();
   m_vecs.push_back(&vec);
 }
 
+//! Add a field that may be modified (see IceModelVec::update_ghosts()).
+void IceModelVec::AccessList::add(IceModelVec &vec) {
+  vec.begin_access();
+  vec.m_write_access = true;
+  m_vecs.push_back(&vec);
+}
+
 void convert_vec(Vec v, units::System::Ptr system,
                  const std::string &spec1, const std::string &spec2) {
   units::Converter c(system, spec1, spec2);
@@ -220,6 +220,9 @@ public:
   virtual void  end_access() const;
   virtual void  update_ghosts();
   virtual void  update_ghosts(IceModelVec &destination) const;
+  void update_ghosts_begin();
+  void update_ghosts_end();
+  bool ghosts_are_current() const;
 
   void  set(double c);
 
@@ -267,6 +270,12 @@ protected:
 
   mutable int m_access_counter;           // used in begin_access() and end_access()
   int m_state_counter;            //!< Internal IceModelVec "revision number"
+  bool m_ghost_update_in_progress; //!< true between update_ghosts_begin() and update_ghosts_end()
+  //! value of m_state_counter at the last ghost update (-1 if ghosts may be out of date)
+  mutable int m_ghosts_state_counter;
+  //! true if this field was accessed for writing since begin_access() (see AccessList)
+  mutable bool m_write_access;
+  double m_ghost_update_time;      //!< time spent in update_ghosts_begin(), in seconds
 
   virtual void checkCompatibility(const char *function, const IceModelVec &other) const;
 
@@ -279,7 +288,17 @@ protected:
                unsigned int count=1) const;
   void set_dof(petsc::DM::Ptr da_source, Vec source, unsigned int n,
                unsigned int count=1);
+
+  void track_memory(Vec v);
+  double ghost_bytes(Vec v) const;
+  void ghosts_updated() const;
+  //! component this field's memory is attributed to (see Profiling::memory_allocated())
+  std::string m_memory_component;
+  //! number of bytes of storage recorded by track_memory()
+  double m_memory_bytes;
 private:
+  friend class GhostExchangeGroup;
+
   // disable copy constructor and the assignment operator:
   IceModelVec(const IceModelVec &other);
   IceModelVec& operator=(const IceModelVec&);
@@ -291,12 +310,18 @@ public:
 public:
 
   //! Makes sure that we call begin_access() and end_access() for all accessed IceModelVecs.
+  /*!
+   * Non-const IceModelVecs are assumed to be modified: their ghosts
+   * are considered out of date once access ends (see update_ghosts()).
+   */
   class AccessList {
   public:
     AccessList();
     AccessList(const IceModelVec &v);
+    AccessList(IceModelVec &v);
     ~AccessList();
     void add(const IceModelVec &v);
+    void add(IceModelVec &v);
   private:
     std::vector<const IceModelVec*> m_vecs;
   };
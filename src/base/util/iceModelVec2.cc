@@ -82,6 +82,7 @@ void  IceModelVec2S::create(IceGrid::ConstPtr my_grid, const std::string &my_nam
 
 double** IceModelVec2S::get_array() {
   begin_access();
+  m_write_access = true;
   return static_cast<double**>(array);
 }
 
@@ -262,6 +263,8 @@ void IceModelVec2S::set_to_magnitude(const IceModelVec2V &input) {
 
     (*this)(i, j) = input(i, j).magnitude();
   }
+
+  inc_state_counter();          // mark as modified
 }
 
 //! Masks out all the areas where \f$ M \le 0 \f$ by setting them to `fill`. 
@@ -591,6 +594,7 @@ double IceModelVec2S::min() const {
 void IceModelVec2::get_component(unsigned int n, IceModelVec2S &result) const {
 
   IceModelVec2::get_dof(result.get_dm(), result.m_v, n);
+  result.inc_state_counter();   // mark as modified
 }
 
 void IceModelVec2::set_component(unsigned int n, const IceModelVec2S &source) {
@@ -623,6 +627,7 @@ void IceModelVec2::create(IceGrid::ConstPtr my_grid, const std::string & my_name
     ierr = DMCreateGlobalVector(*m_da, m_v.rawptr());
     PISM_CHK(ierr, "DMCreateGlobalVector");
   }
+  track_memory(m_v);
 
   m_has_ghosts = (ghostedp == WITH_GHOSTS);
   m_name       = my_name;
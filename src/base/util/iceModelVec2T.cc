@@ -18,6 +18,14 @@
 
 #include <petsc.h>
 #include <algorithm>
+#include <cstring>              // strerror
+#include <cerrno>
+#include <cstdio>               // rename, remove
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "iceModelVec2T.hh"
 #include "base/util/io/PIO.hh"
 #include "pism_const.hh"
@@ -41,12 +49,15 @@ IceModelVec2T::IceModelVec2T() : IceModelVec2S() {
   m_period               = 0;
   m_reference_time       = 0.0;
   n_evaluations_per_year = 53;
+  m_mapped_file          = NULL;
+  m_mapped_size          = 0;
+  m_mapped               = NULL;
 
   m_da3.reset();
 }
 
 IceModelVec2T::~IceModelVec2T() {
-  // empty
+  unmap_cache();
 }
 
 
@@ -75,6 +86,7 @@ void IceModelVec2T::create(IceGrid::ConstPtr my_grid, const std::string &my_shor
   // allocate the 3D Vec:
   PetscErrorCode ierr = DMCreateGlobalVector(*m_da3, m_v3.rawptr());
   PISM_CHK(ierr, "DMCreateGlobalVector");
+  track_memory(m_v3);
 }
 
 double*** IceModelVec2T::get_array3() {
@@ -108,6 +120,12 @@ void IceModelVec2T::init(const std::string &fname, unsigned int period, double r
 
   const Logger &log = *m_grid->ctx()->log();
 
+  // discard records from a previous init() call, including the ones in a
+  // mapped cache file
+  unmap_cache();
+  first = -1;
+  N     = 0;
+
   filename         = fname;
   m_period         = period;
   m_reference_time = reference_time;
@@ -201,6 +219,12 @@ void IceModelVec2T::init(const std::string &fname, unsigned int period, double r
 
   nc.close();
 
+  std::string cache_directory = m_grid->ctx()->config()->get_string("climate_forcing_cache_directory");
+  if (not cache_directory.empty() and time.size() > 1) {
+    map_cache(cache_directory);
+    return;
+  }
+
   if (m_period != 0) {
     if ((size_t)n_records < time.size()) {
       throw RuntimeError("buffer has to be big enough to hold all records of periodic data");
@@ -211,6 +235,177 @@ void IceModelVec2T::init(const std::string &fname, unsigned int period, double r
   }
 }
 
+//! Number of `double`s in the header of a cache file.
+static const size_t cache_header_length = 16;
+//! Cache file format version (stored in the header).
+static const double cache_version = 1.0;
+
+/*!
+ * Map the cache file corresponding to `filename` (all records) into memory,
+ * (re-)building it first if it does not exist or does not match.
+ *
+ * Each processor uses its own file. This is a collective operation: if one
+ * processor has to re-build its file, all of them do it (this involves
+ * reading records from `filename`).
+ *
+ * Note that this does not reduce memory use: the in-memory buffer (`m_v3`,
+ * `n_records` records) is allocated in create(), before we know if a cache
+ * will be used. The cache avoids re-reading and transposing records from
+ * `filename` and lets runs on the same node share the page cache.
+ */
+void IceModelVec2T::map_cache(const std::string &directory) {
+  unmap_cache();
+
+  const unsigned int
+    n_times  = time.size(),
+    n_points = m_grid->xm() * m_grid->ym();
+
+  std::string cache_file;
+  {
+    std::string base = filename;
+    size_t k = base.rfind('/');
+    if (k != std::string::npos) {
+      base = base.substr(k + 1);
+    }
+    std::ostringstream tmp;
+    tmp << directory << "/" << base << "." << m_name << "."
+        << m_grid->size() << "-" << m_grid->rank() << ".bin";
+    cache_file = tmp.str();
+  }
+
+  struct stat source;
+  if (::stat(filename.c_str(), &source) != 0) {
+    throw RuntimeError::formatted("cannot stat '%s': %s", filename.c_str(), strerror(errno));
+  }
+
+  // everything the cached data depends on
+  double header[cache_header_length];
+  for (unsigned int k = 0; k < cache_header_length; ++k) {
+    header[k] = 0.0;
+  }
+  header[0]  = cache_version;
+  header[1]  = source.st_mtime;
+  header[2]  = source.st_size;
+  header[3]  = n_times;
+  header[4]  = m_grid->Mx();
+  header[5]  = m_grid->My();
+  header[6]  = m_grid->xs();
+  header[7]  = m_grid->xm();
+  header[8]  = m_grid->ys();
+  header[9]  = m_grid->ym();
+  header[10] = m_grid->x(0);
+  header[11] = m_grid->x(m_grid->Mx() - 1);
+  header[12] = m_grid->y(0);
+  header[13] = m_grid->y(m_grid->My() - 1);
+
+  const size_t size = (cache_header_length + (size_t)n_points * n_times) * sizeof(double);
+
+  // check if the existing cache file matches
+  double valid = 0.0;
+  {
+    int fd = ::open(cache_file.c_str(), O_RDONLY);
+    if (fd >= 0) {
+      double existing[cache_header_length];
+      struct stat cache;
+      if (::fstat(fd, &cache) == 0 and (size_t)cache.st_size == size and
+          ::read(fd, existing, sizeof(existing)) == (ssize_t)sizeof(existing) and
+          memcmp(existing, header, sizeof(header)) == 0) {
+        valid = 1.0;
+      }
+      ::close(fd);
+    }
+  }
+
+  if (GlobalMin(m_grid->com, valid) < 1.0) {
+    m_grid->ctx()->log()->message(2,
+                                  "  converting \"%s\" (short_name = %s) to a cache file in %s...\n",
+                                  metadata().get_string("long_name").c_str(), m_name.c_str(),
+                                  directory.c_str());
+
+    // Write to a temporary file and rename it when done, so that other runs
+    // using the same cache never see a partially written file.
+    // Processes on different hosts may share the cache directory (and a PID).
+    char hostname[256] = "";
+    ::gethostname(hostname, sizeof(hostname) - 1);
+
+    std::ostringstream tmp;
+    tmp << cache_file << ".tmp." << hostname << "." << m_grid->rank() << "." << ::getpid();
+    const std::string tmp_file = tmp.str();
+
+    int fd = ::open(tmp_file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      throw RuntimeError::formatted("cannot create '%s': %s", tmp_file.c_str(), strerror(errno));
+    }
+    if (::ftruncate(fd, size) != 0) {
+      ::close(fd);
+      throw RuntimeError::formatted("cannot resize '%s': %s", tmp_file.c_str(), strerror(errno));
+    }
+    void *buffer = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (buffer == MAP_FAILED) {
+      throw RuntimeError::formatted("cannot map '%s': %s", tmp_file.c_str(), strerror(errno));
+    }
+
+    double *data = static_cast<double*>(buffer);
+    memcpy(data, header, sizeof(header));
+    data += cache_header_length;
+
+    PIO nc(m_grid->com, "guess_mode");
+    nc.open(filename, PISM_READONLY);
+
+    for (unsigned int r = 0; r < n_times; ++r) {
+      {
+        petsc::VecArray tmp_array(m_v);
+        io::regrid_spatial_variable(m_metadata[0], *m_grid, nc, r,
+                                    CRITICAL, false, 0.0, tmp_array.get());
+      }
+
+      IceModelVec::AccessList list(*this);
+      size_t offset = 0;
+      for (Points p(*m_grid); p; p.next(), ++offset) {
+        data[offset * n_times + r] = (*this)(p.i(), p.j());
+      }
+    }
+
+    nc.close();
+
+    ::munmap(buffer, size);
+
+    if (::rename(tmp_file.c_str(), cache_file.c_str()) != 0) {
+      ::remove(tmp_file.c_str());
+      throw RuntimeError::formatted("cannot rename '%s' to '%s': %s",
+                                    tmp_file.c_str(), cache_file.c_str(), strerror(errno));
+    }
+  }
+
+  int fd = ::open(cache_file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw RuntimeError::formatted("cannot open '%s': %s", cache_file.c_str(), strerror(errno));
+  }
+  void *buffer = ::mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (buffer == MAP_FAILED) {
+    throw RuntimeError::formatted("cannot map '%s': %s", cache_file.c_str(), strerror(errno));
+  }
+
+  m_mapped_file = buffer;
+  m_mapped_size = size;
+  m_mapped      = static_cast<const double*>(buffer) + cache_header_length;
+
+  // all records are available
+  first = 0;
+  N     = n_times;
+}
+
+void IceModelVec2T::unmap_cache() {
+  if (m_mapped_file != NULL) {
+    ::munmap(m_mapped_file, m_mapped_size);
+    m_mapped_file = NULL;
+    m_mapped_size = 0;
+    m_mapped      = NULL;
+  }
+}
+
 //! Initialize as constant in time and space
 void IceModelVec2T::init_constant(double value) {
 
@@ -238,8 +433,8 @@ void IceModelVec2T::update(double my_t, double my_dt) {
     return;
   }
 
-  if (m_period != 0) {
-    // we read all data in IceModelVec2T::init() (see above)
+  if (m_period != 0 or m_mapped != NULL) {
+    // we read (or mapped) all data in IceModelVec2T::init() (see above)
     return;
   }
 
@@ -398,14 +593,11 @@ void IceModelVec2T::set_record(int n) {
 //! Sets the (internal) Vec v to the contents of the nth record.
 void IceModelVec2T::get_record(int n) {
 
-  double  **a2 = get_array();
-  double ***a3 = get_array3();
+  IceModelVec::AccessList list(*this);
   for (Points p(*m_grid); p; p.next()) {
     const int i = p.i(), j = p.j();
-    a2[i][j] = a3[i][j][n];
+    (*this)(i, j) = records(i, j)[n];
   }
-  end_access();
-  end_access();
 }
 
 //! \brief Given the time my_t and the current selected time-step my_dt,
@@ -566,11 +758,11 @@ void IceModelVec2T::init_interpolation(const std::vector<double> &ts) {
  *
  */
 void IceModelVec2T::interp(int i, int j, std::vector<double> &result) {
-  double ***a3 = (double***) array3;
+  const double *values = records(i, j);
   unsigned int ts_length = m_interp_indices.size();
 
   for (unsigned int k = 0; k < ts_length; ++k) {
-    result[k] = a3[i][j][m_interp_indices[k]];
+    result[k] = values[m_interp_indices[k]];
   }
 }
 
@@ -584,8 +776,7 @@ double IceModelVec2T::average(int i, int j) {
   double result = 0.0;
 
   if (N == 1) {
-    double ***a3 = (double***) array3;
-    result = a3[i][j][0];
+    result = records(i, j)[0];
   } else {
     std::vector<double> values(M);
 
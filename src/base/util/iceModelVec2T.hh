@@ -43,6 +43,15 @@ namespace pism {
   Both versions of interp() use piecewise-constant interpolation and
   extrapolate (by a constant) outside the available range.
 
+  If the configuration parameter `climate_forcing_cache_directory` is set,
+  all records of time-dependent forcing are converted (on first use) to a
+  binary file per processor, storing the records of each grid point
+  contiguously, and this file is mapped into memory. Then update() does not
+  read anything and the OS page cache is shared by all runs on a node
+  using the same forcing and grid decomposition. Cache files store the
+  modification time and size of the source file, the grid and the
+  ownership range; a file that does not match is re-built.
+
   Usage example:
   \code
   // initialization:
@@ -129,6 +138,7 @@ protected:
   std::string filename;         //!< file to read (regrid) from
   petsc::DM::Ptr m_da3;
   petsc::Vec m_v3;                       //!< a 3D Vec used to store records
+                                         //!< (allocated even if a cache file is mapped)
   mutable void ***array3;
   unsigned int n_records, //!< maximum number of records to store in memory
     N,                    //!< number of records kept in memory
@@ -141,9 +151,28 @@ protected:
   unsigned int m_period;        // in years
   double m_reference_time;      // in seconds
 
+  //! start of the mapped cache file (see map_cache()) or NULL
+  void *m_mapped_file;
+  //! size of the mapped cache file, in bytes
+  size_t m_mapped_size;
+  //! records stored in the mapped cache file or NULL
+  const double *m_mapped;
+
   double*** get_array3();
   virtual void update(unsigned int start);
   virtual void discard(int N);
+
+  void map_cache(const std::string &directory);
+  void unmap_cache();
+
+  //! Records at the grid point (i,j) (requires begin_access()).
+  inline const double* records(int i, int j) const {
+    if (m_mapped != NULL) {
+      const size_t offset = (i - m_grid->xs()) * m_grid->ym() + (j - m_grid->ys());
+      return m_mapped + offset * time.size();
+    }
+    return reinterpret_cast<double***>(array3)[i][j];
+  }
 };
 
 
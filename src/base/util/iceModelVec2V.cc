@@ -59,6 +59,7 @@ void IceModelVec2V::create(IceGrid::ConstPtr my_grid, const std::string &short_n
 
 Vector2** IceModelVec2V::get_array() {
   begin_access();
+  m_write_access = true;
   return static_cast<Vector2**>(array);
 }
 
@@ -91,6 +91,7 @@ void IceModelVec3D::allocate(IceGrid::ConstPtr my_grid, const std::string &my_na
     ierr = DMCreateGlobalVector(*m_da, m_v.rawptr());
     PISM_CHK(ierr, "DMCreateGlobalVector");
   }
+  track_memory(m_v);
 
   m_name = my_name;
 
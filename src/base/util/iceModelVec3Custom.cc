@@ -67,6 +67,7 @@ void IceModelVec3Custom::create(IceGrid::ConstPtr mygrid,
 
   ierr = DMCreateGlobalVector(*m_da, m_v.rawptr());
   PISM_CHK(ierr, "DMCreateGlobalVector");
+  track_memory(m_v);
 
   m_dof = 1;
 
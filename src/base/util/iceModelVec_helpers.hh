@@ -56,21 +56,24 @@ void add_2d(const IceModelVec* const x_in, double alpha,
   bool scatter = false;
   compute_params(x, y, z, stencil, scatter);
 
-  IceModelVec::AccessList list;
-  list.add(*x);
-  list.add(*y);
-  list.add(*z);
-  for (PointsWithGhosts p(*z->get_grid(), stencil); p; p.next()) {
-    const int i = p.i(), j = p.j();
-
-    (*z)(i, j) = (*x)(i, j) + (*y)(i, j) * alpha;
+  {
+    IceModelVec::AccessList list;
+    list.add(*x);
+    list.add(*y);
+    list.add(*z);
+    for (PointsWithGhosts p(*z->get_grid(), stencil); p; p.next()) {
+      const int i = p.i(), j = p.j();
+
+      (*z)(i, j) = (*x)(i, j) + (*y)(i, j) * alpha;
+    }
   }
 
+  result->inc_state_counter();
+
+  // update ghosts after access ends: ending write access marks them stale
   if (scatter) {
     z->update_ghosts();
   }
-
-  result->inc_state_counter();
 }
 
 template<class V>
@@ -88,20 +91,23 @@ void copy_2d(const IceModelVec* const source,
   bool scatter = false;
   compute_params(x, x, z, stencil, scatter);
 
-  IceModelVec::AccessList list;
-  list.add(*x);
-  list.add(*z);
-  for (PointsWithGhosts p(*z->get_grid(), stencil); p; p.next()) {
-    const int i = p.i(), j = p.j();
+  {
+    IceModelVec::AccessList list;
+    list.add(*x);
+    list.add(*z);
+    for (PointsWithGhosts p(*z->get_grid(), stencil); p; p.next()) {
+      const int i = p.i(), j = p.j();
 
-    (*z)(i, j) = (*x)(i, j);
+      (*z)(i, j) = (*x)(i, j);
+    }
   }
 
+  destination->inc_state_counter();
+
+  // update ghosts after access ends: ending write access marks them stale
   if (scatter) {
     z->update_ghosts();
   }
-
-  destination->inc_state_counter();
 }
 
 } // end of namespace pism
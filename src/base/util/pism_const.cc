@@ -294,9 +294,55 @@ bool set_contains(const std::set<std::string> &S, const std::string &name) {
   return (S.find(name) != S.end());
 }
 
+ReductionCounter::ReductionCounter()
+  : count(0.0), bytes(0.0), time(0.0) {
+  // empty
+}
+
+//! Profiling region global reductions are attributed to
+static std::string reduction_region;
+static ReductionCounters reduction_counters_storage;
+//! true if GlobalReduce() should update reduction counters
+static bool reduction_counting = false;
+
+//! Turn counting of global reductions on or off (see Profiling::set_communication_counting()).
+void set_reduction_counting(bool flag) {
+  reduction_counting = flag;
+}
+
+//! Set the name of the profiling region used to tag global reductions (see Profiling).
+void set_reduction_region(const std::string &region) {
+  reduction_region = region;
+}
+
+//! Counters of global reductions performed on this processor since the beginning of the run.
+const ReductionCounters& reduction_counters() {
+  return reduction_counters_storage;
+}
+
 void GlobalReduce(MPI_Comm comm, double *local, double *result, int count, MPI_Op op) {
+  const double start = MPI_Wtime();
+
   int err = MPI_Allreduce(local, result, count, MPIU_REAL, op, comm);
   PISM_C_CHK(err, 0, "MPI_Allreduce");
+
+  if (not reduction_counting) {
+    return;
+  }
+
+  std::string operation = "GlobalReduce";
+  if (op == MPI_SUM) {
+    operation = "GlobalSum";
+  } else if (op == MPI_MAX) {
+    operation = "GlobalMax";
+  } else if (op == MPI_MIN) {
+    operation = "GlobalMin";
+  }
+
+  ReductionCounter &c = reduction_counters_storage[reduction_region + "\t" + operation];
+  c.count += 1.0;
+  c.bytes += count * sizeof(double);
+  c.time  += MPI_Wtime() - start;
 }
 
 void GlobalMin(MPI_Comm comm, double *local, double *result, int count) {
@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <map>
 
 namespace pism {
 
@@ -71,6 +72,21 @@ double GlobalMax(MPI_Comm comm, double local);
 
 double GlobalSum(MPI_Comm comm, double local);
 
+//! Number of calls, bytes and time (in seconds) spent in global reductions on this processor.
+struct ReductionCounter {
+  ReductionCounter();
+  double count;
+  double bytes;
+  double time;
+};
+
+//! Reduction counters indexed by "region<TAB>operation" (see set_reduction_region()).
+typedef std::map<std::string, ReductionCounter> ReductionCounters;
+
+void set_reduction_counting(bool flag);
+void set_reduction_region(const std::string &region);
+const ReductionCounters& reduction_counters();
+
 } // end of namespace pism
 
 #endif
@@ -57,6 +57,23 @@ public:
   //! grid. Times (in years) are specified in ts. NB! Has to be surrounded by
   //! begin_pointwise_access() and end_pointwise_access()
   virtual void temp_time_series(int i, int j, std::vector<double> &result) = 0;
+
+  //! \brief Sets a pre-allocated (ym*N)-element array "result" to
+  //! time-series of near-surface air temperature at points (i,j), ys <= j <
+  //! ys + ym, owned by this processor. The time-series at (i,j) starts at
+  //! result[(j - ys) * N].
+  //!
+  //! Here N is the number of times passed to init_timeseries(). Processes one
+  //! grid row at a time, in the order used by `Points`, so that modifiers can
+  //! apply corrections to many points at once. The default implementation
+  //! calls temp_time_series(i, j, ...) for each point.
+  virtual void temp_time_series_row(int i, std::vector<double> &result);
+
+  //! \brief Sets a pre-allocated (ym*N)-element array "result" to
+  //! time-series of ice-equivalent precipitation (m/s) in the row i.
+  //!
+  //! See temp_time_series_row() for more.
+  virtual void precip_time_series_row(int i, std::vector<double> &result);
   //! \brief Sets result to a snapshot of temperature for the current time.
   //! (For diagnostic purposes.)
   virtual void temp_snapshot(IceModelVec2S &result) = 0;
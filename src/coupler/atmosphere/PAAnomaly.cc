@@ -161,6 +161,35 @@ void Anomaly::precip_time_series(int i, int j, std::vector<double> &result) {
   }
 }
 
+void Anomaly::temp_time_series_row(int i, std::vector<double> &result) {
+  input_model->temp_time_series_row(i, result);
+  add_anomaly_row(*air_temp_anomaly, i, m_temp_anomaly, result);
+}
+
+void Anomaly::precip_time_series_row(int i, std::vector<double> &result) {
+  input_model->precip_time_series_row(i, result);
+  add_anomaly_row(*precipitation_anomaly, i, m_mass_flux_anomaly, result);
+}
+
+//! Add time-series of `anomaly` to time-series in the row i (see temp_time_series_row()).
+void Anomaly::add_anomaly_row(IceModelVec2T &anomaly, int i,
+                              std::vector<double> &tmp,
+                              std::vector<double> &result) {
+  const unsigned int N = m_ts_times.size();
+  const int ys = m_grid->ys(), ym = m_grid->ym();
+
+  tmp.resize(N);
+
+  for (int j = ys; j < ys + ym; ++j) {
+    anomaly.interp(i, j, tmp);
+
+    double *values = &result[(j - ys) * N];
+    for (unsigned int k = 0; k < N; ++k) {
+      values[k] += tmp[k];
+    }
+  }
+}
+
 void Anomaly::add_vars_to_output_impl(const std::string &keyword, std::set<std::string> &result) {
   input_model->add_vars_to_output(keyword, result);
 
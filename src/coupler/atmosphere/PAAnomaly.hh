@@ -43,6 +43,8 @@ public:
   virtual void end_pointwise_access();
   virtual void temp_time_series(int i, int j, std::vector<double> &values);
   virtual void precip_time_series(int i, int j, std::vector<double> &values);
+  virtual void temp_time_series_row(int i, std::vector<double> &values);
+  virtual void precip_time_series_row(int i, std::vector<double> &values);
 
 protected:
   virtual void update_impl(double my_t, double my_dt);
@@ -55,6 +57,9 @@ protected:
   SpatialVariableMetadata air_temp, precipitation;
   IceModelVec2T *air_temp_anomaly, *precipitation_anomaly;
   std::vector<double> m_mass_flux_anomaly, m_temp_anomaly;
+private:
+  void add_anomaly_row(IceModelVec2T &anomaly, int i,
+                       std::vector<double> &tmp, std::vector<double> &result);
 };
 
 } // end of namespace atmosphere
@@ -144,6 +144,7 @@ void PIK::init() {
   int start = -1;
 
   m_t = m_dt = GSL_NAN;  // every re-init restarts the clock
+  m_inputs.reset();
 
   m_log->message(2,
              "* Initializing the constant-in-time atmosphere model PIK.\n"
@@ -178,6 +179,12 @@ void PIK::update_impl(double, double) {
     *usurf = m_grid->variables().get_2d_scalar("surface_altitude"),
     *lat   = m_grid->variables().get_2d_scalar("latitude");
 
+  m_inputs.add(*usurf);
+  m_inputs.add(*lat);
+  if (not m_inputs.changed()) {
+    return;
+  }
+
   IceModelVec::AccessList list;
   list.add(m_air_temp);
   list.add(*usurf);
@@ -21,6 +21,7 @@
 
 #include "base/util/iceModelVec.hh"
 #include "coupler/PISMAtmosphere.hh"
+#include "coupler/util/PInputTracker.hh"
 
 namespace pism {
 namespace atmosphere {
@@ -48,6 +49,8 @@ protected:
   std::string m_input_file;
   IceModelVec2S m_precipitation, m_air_temp;
   SpatialVariableMetadata m_air_temp_snapshot;
+  //! inputs of the air temperature parameterization
+  InputTracker m_inputs;
 };
 
 } // end of namespace atmosphere
@@ -17,6 +17,7 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <gsl/gsl_math.h>
+#include <algorithm>
 
 #include "PAGivenClimate.hh"
 #include "base/util/IceGrid.hh"
@@ -120,6 +121,27 @@ void Given::precip_time_series(int i, int j, std::vector<double> &result) {
   precipitation->interp(i, j, result);
 }
 
+void Given::temp_time_series_row(int i, std::vector<double> &result) {
+  interp_row(*air_temp, i, result);
+}
+
+void Given::precip_time_series_row(int i, std::vector<double> &result) {
+  interp_row(*precipitation, i, result);
+}
+
+//! Copy time-series of `input` in the row i into `result` (see temp_time_series_row()).
+void Given::interp_row(IceModelVec2T &input, int i, std::vector<double> &result) {
+  const unsigned int N = m_ts_times.size();
+  const int ys = m_grid->ys(), ym = m_grid->ym();
+
+  m_column.resize(N);
+
+  for (int j = ys; j < ys + ym; ++j) {
+    input.interp(i, j, m_column);
+    std::copy(m_column.begin(), m_column.end(), result.begin() + (j - ys) * N);
+  }
+}
+
 void Given::init_timeseries(const std::vector<double> &ts) {
 
   air_temp->init_interpolation(ts);
@@ -43,9 +43,14 @@ public:
   virtual void init_timeseries(const std::vector<double> &ts);
   virtual void temp_time_series(int i, int j, std::vector<double> &values);
   virtual void precip_time_series(int i, int j, std::vector<double> &values);
+  virtual void temp_time_series_row(int i, std::vector<double> &values);
+  virtual void precip_time_series_row(int i, std::vector<double> &values);
 protected:
   virtual void update_impl(double my_t, double my_dt);
   IceModelVec2T *precipitation, *air_temp;
+private:
+  void interp_row(IceModelVec2T &input, int i, std::vector<double> &result);
+  std::vector<double> m_column;
 };
 
 } // end of namespace atmosphere
@@ -140,6 +140,38 @@ void LapseRates::precip_time_series(int i, int j, std::vector<double> &result) {
   }
 }
 
+void LapseRates::temp_time_series_row(int i, std::vector<double> &result) {
+  input_model->temp_time_series_row(i, result);
+  lapse_rate_correction_row(i, m_temp_lapse_rate, result);
+}
+
+void LapseRates::precip_time_series_row(int i, std::vector<double> &result) {
+  input_model->precip_time_series_row(i, result);
+  lapse_rate_correction_row(i, m_precip_lapse_rate, result);
+}
+
+//! Apply the lapse rate correction to time-series in the row i (see temp_time_series_row()).
+void LapseRates::lapse_rate_correction_row(int i, double lapse_rate,
+                                           std::vector<double> &result) {
+  const unsigned int N = m_ts_times.size();
+  const int ys = m_grid->ys(), ym = m_grid->ym();
+
+  m_usurf.resize(N);
+
+  assert(m_surface != NULL);
+
+  for (int j = ys; j < ys + ym; ++j) {
+    m_reference_surface.interp(i, j, m_usurf);
+
+    const double surface = (*m_surface)(i, j);
+    double *values = &result[(j - ys) * N];
+
+    for (unsigned int m = 0; m < N; ++m) {
+      values[m] -= lapse_rate * (surface - m_usurf[m]);
+    }
+  }
+}
+
 void LapseRates::temp_snapshot(IceModelVec2S &result) {
   input_model->temp_snapshot(result);
   lapse_rate_correction(result, m_temp_lapse_rate);
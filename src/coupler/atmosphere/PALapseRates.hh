@@ -42,6 +42,8 @@ public:
   virtual void init_timeseries(const std::vector<double> &ts);
   virtual void precip_time_series(int i, int j, std::vector<double> &result);
   virtual void temp_time_series(int i, int j, std::vector<double> &result);
+  virtual void precip_time_series_row(int i, std::vector<double> &result);
+  virtual void temp_time_series_row(int i, std::vector<double> &result);
 
   virtual void temp_snapshot(IceModelVec2S &result);
 
@@ -54,6 +56,9 @@ protected:
   double m_precip_lapse_rate;
   SpatialVariableMetadata m_precipitation, m_air_temp;
   const IceModelVec2S *m_surface;
+private:
+  void lapse_rate_correction_row(int i, double lapse_rate, std::vector<double> &result);
+  std::vector<double> m_usurf;
 };
 
 } // end of namespace atmosphere
@@ -74,6 +74,20 @@ public:
     }
   }
 
+  virtual void temp_time_series_row(int i, std::vector<double> &result)
+  {
+    if (input_model != NULL) {
+      input_model->temp_time_series_row(i, result);
+    }
+  }
+
+  virtual void precip_time_series_row(int i, std::vector<double> &result)
+  {
+    if (input_model != NULL) {
+      input_model->precip_time_series_row(i, result);
+    }
+  }
+
   virtual void temp_snapshot(IceModelVec2S &result)
   {
     if (input_model != NULL) {
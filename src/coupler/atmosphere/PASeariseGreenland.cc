@@ -51,6 +51,7 @@ SeaRISEGreenland::~SeaRISEGreenland() {
 void SeaRISEGreenland::init() {
 
   m_t = m_dt = GSL_NAN;  // every re-init restarts the clock
+  m_inputs.reset();
 
   m_log->message(2,
              "* Initializing SeaRISE-Greenland atmosphere model based on the Fausto et al (2009)\n"
@@ -85,6 +86,20 @@ void SeaRISEGreenland::precip_time_series(int i, int j, std::vector<double> &res
   }
 }
 
+void SeaRISEGreenland::precip_time_series_row(int i, std::vector<double> &result) {
+  const unsigned int N = m_ts_times.size();
+  const int ys = m_grid->ys(), ym = m_grid->ym();
+
+  for (int j = ys; j < ys + ym; ++j) {
+    const double P = m_precipitation(i,j);
+    double *values = &result[(j - ys) * N];
+
+    for (unsigned int k = 0; k < N; ++k) {
+      values[k] = P;
+    }
+  }
+}
+
 MaxTimestep SeaRISEGreenland::max_timestep_impl(double t) {
   (void) t;
   return MaxTimestep();
@@ -95,14 +110,23 @@ MaxTimestep SeaRISEGreenland::max_timestep_impl(double t) {
 //! to be updated.
 void SeaRISEGreenland::update_impl(double my_t, double my_dt) {
 
-  if ((fabs(my_t - m_t) < 1e-12) &&
-      (fabs(my_dt - m_dt) < 1e-12)) {
-    return;
-  }
-
   m_t  = my_t;
   m_dt = my_dt;
 
+  // initialize pointers to fields the parameterization depends on:
+  const IceModelVec2S
+    &h        = *m_grid->variables().get_2d_scalar("surface_altitude"),
+    &lat_degN = *m_grid->variables().get_2d_scalar("latitude"),
+    &lon_degE = *m_grid->variables().get_2d_scalar("longitude");
+
+  // the parameterization does not depend on time
+  m_inputs.add(h);
+  m_inputs.add(lat_degN);
+  m_inputs.add(lon_degE);
+  if (not m_inputs.changed()) {
+    return;
+  }
+
   const double
     d_ma     = m_config->get_double("snow_temp_fausto_d_ma"),      // K
     gamma_ma = m_config->get_double("snow_temp_fausto_gamma_ma"),  // K m-1
@@ -113,13 +137,6 @@ void SeaRISEGreenland::update_impl(double my_t, double my_dt) {
     c_mj     = m_config->get_double("snow_temp_fausto_c_mj"),
     kappa_mj = m_config->get_double("snow_temp_fausto_kappa_mj");
 
-
-  // initialize pointers to fields the parameterization depends on:
-  const IceModelVec2S
-    &h        = *m_grid->variables().get_2d_scalar("surface_altitude"),
-    &lat_degN = *m_grid->variables().get_2d_scalar("latitude"),
-    &lon_degE = *m_grid->variables().get_2d_scalar("longitude");
-
   if (lat_degN.metadata().has_attribute("missing_at_bootstrap")) {
     throw RuntimeError("latitude variable was missing at bootstrap;\n"
                        "SeaRISE-Greenland atmosphere model depends on latitude and would return nonsense!");
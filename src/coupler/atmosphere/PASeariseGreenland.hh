@@ -22,6 +22,7 @@
 
 #include "PAYearlyCycle.hh"
 #include "base/util/Timeseries.hh"
+#include "coupler/util/PInputTracker.hh"
 
 namespace pism {
 namespace atmosphere {
@@ -36,9 +37,13 @@ public:
 
   virtual void init();
   virtual void precip_time_series(int i, int j, std::vector<double> &values);
+  virtual void precip_time_series_row(int i, std::vector<double> &result);
 protected:
   virtual MaxTimestep max_timestep_impl(double t);
   virtual void update_impl(double my_t, double my_dt);
+private:
+  //! inputs of the temperature parameterization
+  InputTracker m_inputs;
 };
 
 
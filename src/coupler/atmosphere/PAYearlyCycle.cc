@@ -194,6 +194,36 @@ void YearlyCycle::temp_time_series(int i, int j, std::vector<double> &result) {
   }
 }
 
+void YearlyCycle::precip_time_series_row(int i, std::vector<double> &result) {
+  const unsigned int N = m_ts_times.size();
+  const int ys = m_grid->ys(), ym = m_grid->ym();
+
+  for (int j = ys; j < ys + ym; ++j) {
+    const double P = m_precipitation(i,j);
+    double *values = &result[(j - ys) * N];
+
+    for (unsigned int k = 0; k < N; ++k) {
+      values[k] = P;
+    }
+  }
+}
+
+void YearlyCycle::temp_time_series_row(int i, std::vector<double> &result) {
+  const unsigned int N = m_ts_times.size();
+  const int ys = m_grid->ys(), ym = m_grid->ym();
+
+  for (int j = ys; j < ys + ym; ++j) {
+    const double
+      T_annual = m_air_temp_mean_annual(i,j),
+      T_july   = m_air_temp_mean_july(i,j);
+    double *values = &result[(j - ys) * N];
+
+    for (unsigned int k = 0; k < N; ++k) {
+      values[k] = T_annual + (T_july - T_annual) * m_cosine_cycle[k];
+    }
+  }
+}
+
 void YearlyCycle::temp_snapshot(IceModelVec2S &result) {
   const double
     julyday_fraction = m_grid->ctx()->time()->day_of_the_year_to_day_fraction(m_snow_temp_july_day),
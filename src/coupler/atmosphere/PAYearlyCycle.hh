@@ -45,6 +45,8 @@ public:
   virtual void init_timeseries(const std::vector<double> &ts);
   virtual void temp_time_series(int i, int j, std::vector<double> &result);
   virtual void precip_time_series(int i, int j, std::vector<double> &result);
+  virtual void temp_time_series_row(int i, std::vector<double> &result);
+  virtual void precip_time_series_row(int i, std::vector<double> &result);
 protected:
   virtual void update_impl(double my_t, double my_dt) = 0;
   virtual void write_variables_impl(const std::set<std::string> &vars, const PIO &nc);
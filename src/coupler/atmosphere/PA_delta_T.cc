@@ -20,6 +20,7 @@
 
 #include "PA_delta_T.hh"
 #include "base/util/PISMConfigInterface.hh"
+#include "base/util/IceGrid.hh"
 #include "base/util/io/io_helpers.hh"
 
 namespace pism {
@@ -72,16 +73,11 @@ void Delta_T::init_timeseries(const std::vector<double> &ts) {
 
   PAModifier::init_timeseries(ts);
 
-  m_offset_values.resize(m_ts_times.size());
-  for (unsigned int k = 0; k < m_ts_times.size(); ++k) {
-    m_offset_values[k] = (*offset)(m_ts_times[k]);
-  }
+  offset->evaluate(m_ts_times, m_offset_values);
 }
 
 void Delta_T::mean_annual_temp(IceModelVec2S &result) {
-
-  input_model->mean_annual_temp(result);
-  offset_data(result);
+  compute_chain("air_temp", &AtmosphereModel::mean_annual_temp, result);
 }
 
 void Delta_T::temp_time_series(int i, int j, std::vector<double> &result) {
@@ -92,9 +88,33 @@ void Delta_T::temp_time_series(int i, int j, std::vector<double> &result) {
   }
 }
 
+void Delta_T::temp_time_series_row(int i, std::vector<double> &result) {
+  input_model->temp_time_series_row(i, result);
+
+  const unsigned int
+    N      = m_ts_times.size(),
+    length = m_grid->ym() * N;
+
+  for (unsigned int n = 0; n < length; n += N) {
+    for (unsigned int k = 0; k < N; ++k) {
+      result[n + k] += m_offset_values[k];
+    }
+  }
+}
+
 void Delta_T::temp_snapshot(IceModelVec2S &result) {
-  input_model->temp_snapshot(result);
-  offset_data(result);
+  compute_chain("air_temp_snapshot", &AtmosphereModel::temp_snapshot, result);
+}
+
+bool Delta_T::transformation(const std::string &name, double &scale, double &shift) {
+  if (name == "air_temp" or name == "air_temp_snapshot") {
+    scale = 1.0;
+    shift = current_offset();
+  } else {
+    scale = 1.0;
+    shift = 0.0;
+  }
+  return true;
 }
 
 void Delta_T::add_vars_to_output_impl(const std::string &keyword, std::set<std::string> &result) {
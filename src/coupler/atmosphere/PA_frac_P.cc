@@ -20,6 +20,7 @@
 
 #include "PA_frac_P.hh"
 #include "base/util/PISMConfigInterface.hh"
+#include "base/util/IceGrid.hh"
 #include "base/util/io/io_helpers.hh"
 
 namespace pism {
@@ -75,15 +76,22 @@ void Frac_P::init_timeseries(const std::vector<double> &ts) {
 
   PAModifier::init_timeseries(ts);
 
-  m_offset_values.resize(m_ts_times.size());
-  for (unsigned int k = 0; k < m_ts_times.size(); ++k) {
-    m_offset_values[k] = (*offset)(m_ts_times[k]);
-  }
+  offset->evaluate(m_ts_times, m_offset_values);
 }
 
 void Frac_P::mean_precipitation(IceModelVec2S &result) {
-  input_model->mean_precipitation(result);
-  scale_data(result);
+  compute_chain("precipitation", &AtmosphereModel::mean_precipitation, result);
+}
+
+bool Frac_P::transformation(const std::string &name, double &scale, double &shift) {
+  if (name == "precipitation") {
+    scale = current_offset();
+    shift = 0.0;
+  } else {
+    scale = 1.0;
+    shift = 0.0;
+  }
+  return true;
 }
 
 void Frac_P::precip_time_series(int i, int j, std::vector<double> &result) {
@@ -94,6 +102,20 @@ void Frac_P::precip_time_series(int i, int j, std::vector<double> &result) {
   }
 }
 
+void Frac_P::precip_time_series_row(int i, std::vector<double> &result) {
+  input_model->precip_time_series_row(i, result);
+
+  const unsigned int
+    N      = m_ts_times.size(),
+    length = m_grid->ym() * N;
+
+  for (unsigned int n = 0; n < length; n += N) {
+    for (unsigned int k = 0; k < N; ++k) {
+      result[n + k] *= m_offset_values[k];
+    }
+  }
+}
+
 void Frac_P::add_vars_to_output_impl(const std::string &keyword,
                                    std::set<std::string> &result) {
   input_model->add_vars_to_output(keyword, result);
@@ -20,6 +20,7 @@
 
 #include "PA_paleo_precip.hh"
 #include "base/util/PISMConfigInterface.hh"
+#include "base/util/IceGrid.hh"
 #include "base/util/io/io_helpers.hh"
 
 namespace pism {
@@ -85,8 +86,18 @@ void PaleoPrecip::init_timeseries(const std::vector<double> &ts) {
 }
 
 void PaleoPrecip::mean_precipitation(IceModelVec2S &result) {
-  input_model->mean_precipitation(result);
-  result.scale(exp(m_precipexpfactor * (*offset)(m_t + 0.5 * m_dt)));
+  compute_chain("precipitation", &AtmosphereModel::mean_precipitation, result);
+}
+
+bool PaleoPrecip::transformation(const std::string &name, double &scale, double &shift) {
+  if (name == "precipitation") {
+    scale = exp(m_precipexpfactor * current_offset());
+    shift = 0.0;
+  } else {
+    scale = 1.0;
+    shift = 0.0;
+  }
+  return true;
 }
 
 void PaleoPrecip::precip_time_series(int i, int j, std::vector<double> &result) {
@@ -97,6 +108,20 @@ void PaleoPrecip::precip_time_series(int i, int j, std::vector<double> &result)
   }
 }
 
+void PaleoPrecip::precip_time_series_row(int i, std::vector<double> &result) {
+  input_model->precip_time_series_row(i, result);
+
+  const unsigned int
+    N      = m_ts_times.size(),
+    length = m_grid->ym() * N;
+
+  for (unsigned int n = 0; n < length; n += N) {
+    for (unsigned int k = 0; k < N; ++k) {
+      result[n + k] *= m_scaling_values[k];
+    }
+  }
+}
+
 void PaleoPrecip::add_vars_to_output_impl(const std::string &keyword, std::set<std::string> &result) {
   input_model->add_vars_to_output(keyword, result);
 
@@ -62,9 +62,11 @@ public:
   virtual void mean_precipitation(IceModelVec2S &result);
 
   virtual void precip_time_series(int i, int j, std::vector<double> &values);
+  virtual void precip_time_series_row(int i, std::vector<double> &values);
 
 protected:
   virtual MaxTimestep max_timestep_impl(double t);
+  virtual bool transformation(const std::string &name, double &scale, double &shift);
   virtual void write_variables_impl(const std::set<std::string> &vars, const PIO &nc);
   virtual void add_vars_to_output_impl(const std::string &keyword, std::set<std::string> &result);
   virtual void define_variables_impl(const std::set<std::string> &vars, const PIO &nc,
@@ -0,0 +1,61 @@
+/* Copyright (C) 2015 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <algorithm>
+
+#include "coupler/PISMAtmosphere.hh"
+#include "base/util/IceGrid.hh"
+
+namespace pism {
+namespace atmosphere {
+
+void AtmosphereModel::temp_time_series_row(int i, std::vector<double> &result) {
+  const int ys = m_grid->ys(), ym = m_grid->ym();
+
+  if (ym == 0) {
+    return;
+  }
+
+  const unsigned int N = result.size() / ym;
+  std::vector<double> column(N);
+
+  for (int j = ys; j < ys + ym; ++j) {
+    temp_time_series(i, j, column);
+    std::copy(column.begin(), column.end(), result.begin() + (j - ys) * N);
+  }
+}
+
+void AtmosphereModel::precip_time_series_row(int i, std::vector<double> &result) {
+  const int ys = m_grid->ys(), ym = m_grid->ym();
+
+  if (ym == 0) {
+    return;
+  }
+
+  const unsigned int N = result.size() / ym;
+  std::vector<double> column(N);
+
+  for (int j = ys; j < ys + ym; ++j) {
+    precip_time_series(i, j, column);
+    std::copy(column.begin(), column.end(), result.begin() + (j - ys) * N);
+  }
+}
+
+} // end of namespace atmosphere
+} // end of namespace pism
@@ -19,11 +19,13 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_poly.h>
 #include <cassert>
+#include <algorithm>            // std::min, std::max
 
 #include "POGivenTH.hh"
 #include "base/util/IceGrid.hh"
 #include "base/util/PISMVars.hh"
 #include "base/util/PISMConfigInterface.hh"
+#include "base/util/Mask.hh"
 
 namespace pism {
 namespace ocean {
@@ -170,6 +172,44 @@ void GivenTH::melange_back_pressure_fraction_impl(IceModelVec2S &result) {
   result.set(0.0);
 }
 
+//* Evaluate the parameterization of the melting point temperature.
+/** The value returned is in degrees Celsius.
+ */
+static double melting_point_temperature(const GivenTH::Constants &c,
+                                        double salinity, double ice_thickness) {
+  return c.a[0] * salinity + c.a[1] + c.a[2] * ice_thickness;
+}
+
+/** Melt rate, obtained by solving the salt flux balance equation.
+ *
+ * @param c model constants
+ * @param sea_water_salinity sea water salinity
+ * @param basal_salinity shelf base salinity
+ *
+ * @return shelf base melt rate, in [m/s]
+ */
+static double shelf_base_melt_rate(const GivenTH::Constants &c,
+                                   double sea_water_salinity, double basal_salinity) {
+
+  return c.gamma_S * c.sea_water_density * (sea_water_salinity - basal_salinity) / (c.ice_density * basal_salinity);
+}
+
+/** The bigger root of the quadratic equation @f$ A x^2 + B x + C = 0 @f$.
+ *
+ * Uses the same arithmetic as `gsl_poly_solve_quadratic()` in the case of two
+ * distinct roots and @f$ B \ne 0 @f$, which is the only case that occurs in the
+ * sub-shelf melt and freeze-on regimes (@f$ A > 0 @f$ and @f$ C < 0 @f$). Written
+ * without branches so that loops calling it can be vectorized.
+ */
+static inline double bigger_root(double A, double B, double C) {
+  const double
+    sgnb = B > 0.0 ? 1.0 : -1.0,
+    temp = -0.5 * (B + sgnb * sqrt(B * B - 4.0 * A * C)),
+    r1   = temp / A,
+    r2   = C / temp;
+  return std::max(r1, r2);
+}
+
 void GivenTH::update_impl(double my_t, double my_dt) {
 
   // Make sure that sea water salinity and sea water potential
@@ -183,32 +223,79 @@ void GivenTH::update_impl(double my_t, double my_dt) {
 
   const IceModelVec2S *ice_thickness = m_grid->variables().get_2d_scalar("land_ice_thickness");
 
+  // Skip cells that are fully grounded. With the sub-grid grounding line
+  // basal melt parameterization IceModel::combine_basal_melt_rate() uses
+  // shelf base mass flux in grounded cells with gl_mask < 1, so we use
+  // gl_mask (instead of the cell type mask) in that case.
+  const IceModelVec2Int *mask = NULL;
+  const IceModelVec2S *gl_mask = NULL;
+  if (m_config->get_boolean("ocean_three_equation_model_skip_grounded")) {
+    const bool sub_gl = (m_config->get_boolean("sub_groundingline") and
+                         m_config->get_boolean("sub_groundingline_basal_melt"));
+    if (sub_gl) {
+      if (m_grid->variables().is_available("gl_mask")) {
+        gl_mask = m_grid->variables().get_2d_scalar("gl_mask");
+      }
+    } else if (m_grid->variables().is_available("mask")) {
+      mask = m_grid->variables().get_2d_mask("mask");
+    }
+  }
+
   IceModelVec::AccessList list;
   list.add(*ice_thickness);
   list.add(*m_theta_ocean);
   list.add(*m_salinity_ocean);
   list.add(m_shelfbtemp);
   list.add(m_shelfbmassflux);
+  if (mask != NULL) {
+    list.add(*mask);
+  }
+  if (gl_mask != NULL) {
+    list.add(*gl_mask);
+  }
+
+  m_cell_i.clear();
+  m_cell_j.clear();
+  m_cell_salinity.clear();
+  m_cell_theta.clear();
+  m_cell_thickness.clear();
 
   for (Points p(*m_grid); p; p.next()) {
     const int i = p.i(), j = p.j();
 
-    double potential_temperature_celsius = (*m_theta_ocean)(i,j) - 273.15;
+    const bool fully_grounded = ((mask != NULL and mask::grounded(mask->as_int(i, j))) or
+                                 (gl_mask != NULL and (*gl_mask)(i, j) == 1.0));
 
-    double
-      shelf_base_temp_celsius = 0.0,
-      shelf_base_massflux     = 0.0;
+    if (fully_grounded) {
+      // Convert from Celsius to Kelvin:
+      m_shelfbtemp(i,j)     = melting_point_temperature(c, (*m_salinity_ocean)(i,j),
+                                                        (*ice_thickness)(i,j)) + 273.15;
+      m_shelfbmassflux(i,j) = 0.0;
+      continue;
+    }
+
+    m_cell_i.push_back(i);
+    m_cell_j.push_back(j);
+    m_cell_salinity.push_back((*m_salinity_ocean)(i,j));
+    m_cell_theta.push_back((*m_theta_ocean)(i,j) - 273.15);
+    m_cell_thickness.push_back((*ice_thickness)(i,j));
+  }
 
-    pointwise_update(c,
-                     (*m_salinity_ocean)(i,j),
-                     potential_temperature_celsius,
-                     (*ice_thickness)(i,j),
-                     &shelf_base_temp_celsius,
-                     &shelf_base_massflux);
+  const unsigned int N = m_cell_i.size();
+  m_cell_temperature.resize(N);
+  m_cell_melt_rate.resize(N);
+
+  if (N > 0) {
+    update_cells(c, N, &m_cell_salinity[0], &m_cell_theta[0], &m_cell_thickness[0],
+                 &m_cell_temperature[0], &m_cell_melt_rate[0]);
+  }
+
+  for (unsigned int k = 0; k < N; ++k) {
+    const int i = m_cell_i[k], j = m_cell_j[k];
 
     // Convert from Celsius to Kelvin:
-    m_shelfbtemp(i,j)     = shelf_base_temp_celsius + 273.15;
-    m_shelfbmassflux(i,j) = shelf_base_massflux;
+    m_shelfbtemp(i,j)     = m_cell_temperature[k] + 273.15;
+    m_shelfbmassflux(i,j) = m_cell_melt_rate[k];
   }
 
   // convert mass flux from [m s-1] to [kg m-2 s-1]:
@@ -216,26 +303,69 @@ void GivenTH::update_impl(double my_t, double my_dt) {
 }
 
 
-//* Evaluate the parameterization of the melting point temperature.
-/** The value returned is in degrees Celsius.
- */
-static double melting_point_temperature(GivenTH::Constants c,
-                                        double salinity, double ice_thickness) {
-  return c.a[0] * salinity + c.a[1] + c.a[2] * ice_thickness;
-}
-
-/** Melt rate, obtained by solving the salt flux balance equation.
+/** @brief Compute basal salinity in the case of no basal melt and no
+ * freeze-on, with the diffusion-only temperature distribution in the
+ * ice column.
  *
- * @param c model constants
- * @param sea_water_salinity sea water salinity
- * @param basal_salinity shelf base salinity
+ * In this case the temperature gradient at the base ([@ref
+ * HollandJenkins1999], equation 21) is
  *
- * @return shelf base melt rate, in [m/s]
+ * @f[ T_{\text{grad}} = \frac{\Delta T}{h}, @f]
+ *
+ * where @f$ h @f$ is the ice shelf thickness and @f$ \Delta T = T^S -
+ * T^B @f$ is the difference between the temperature at the top and
+ * the bottom of the shelf.
+ *
+ * In this case the coefficients of the quadratic equation for the basal salinity are:
+ *
+ * @f{align*}{
+ * A &= - \frac{b_{0}\,\gamma_T\,h\,\rho_W\,c_{pW}-a_{0}\,\rho_I\,c_{pI}\,\kappa}{h\,\rho_W}\\
+ * B &= \frac{\rho_I\,c_{pI}\,\kappa\,\left(T^S-a_{2}\,h-a_{1}\right)}{h\,\rho_W}
+ +\gamma_S\,L+\gamma_T\,c_{pW}\,\left(\Theta^W-b_{2}\,h-b_{1}\right)\\
+ * C &= -\gamma_S\,S^W\,L\\
+ * @f}
+ *
+ * @param[in] c model constants
+ * @param[in] sea_water_salinity sea water salinity
+ * @param[in] sea_water_potential_temperature sea water potential temperature
+ * @param[in] thickness ice shelf thickness
+ * @param[out] shelf_base_salinity resulting basal salinity
+ *
+ * @return 0 on success
  */
-static double shelf_base_melt_rate(GivenTH::Constants c,
-                                   double sea_water_salinity, double basal_salinity) {
+void GivenTH::subshelf_salinity_diffusion_only(const Constants &c,
+                                                           double sea_water_salinity,
+                                                           double sea_water_potential_temperature,
+                                                           double thickness,
+                                                           double *shelf_base_salinity) {
+  const double
+    c_pI    = c.ice_specific_heat_capacity,
+    c_pW    = c.sea_water_specific_heat_capacity,
+    L       = c.water_latent_heat_fusion,
+    T_S     = c.shelf_top_surface_temperature,
+    S_W     = sea_water_salinity,
+    Theta_W = sea_water_potential_temperature,
+    h       = thickness,
+    rho_W   = c.sea_water_density,
+    rho_I   = c.ice_density,
+    kappa   = c.ice_thermal_diffusivity;
 
-  return c.gamma_S * c.sea_water_density * (sea_water_salinity - basal_salinity) / (c.ice_density * basal_salinity);
+  // We solve a quadratic equation for Sb, the salinity at the shelf
+  // base.
+  //
+  // A*Sb^2 + B*Sb + C = 0
+  const double A = -(c.b[0] * c.gamma_T * h * rho_W * c_pW - c.a[0] * rho_I * c_pI * kappa) / (h * rho_W);
+  const double B = ((rho_I * c_pI * kappa * (T_S - c.a[2] * h - c.a[1])) / (h * rho_W) +
+                    c.gamma_S * L + c.gamma_T * c_pW * (Theta_W - c.b[2] * h - c.b[1]));
+  const double C = -c.gamma_S * S_W * L;
+
+  double S1 = 0.0, S2 = 0.0;
+  const int n_roots = gsl_poly_solve_quadratic(A, B, C, &S1, &S2);
+
+  assert(n_roots > 0);
+  assert(S2 > 0.0);             // The bigger root should be positive.
+
+  *shelf_base_salinity = S2;
 }
 
 /** @brief Compute temperature and melt rate at the base of the shelf.
@@ -339,9 +469,7 @@ static double shelf_base_melt_rate(GivenTH::Constants c,
  * Treating ice thickness, sea water salinity, and sea water potential
  * temperature as "known" and choosing an approximation of the
  * temperature gradient at the base @f$ T_{\text{grad}} @f$ (see
- * subshelf_salinity_melt(), subshelf_salinity_freeze_on(),
- * subshelf_salinity_diffusion_only()) we can write down a system of
- * equations
+ * below) we can write down a system of equations
  *
  * @f{align*}{
  * Q_T &= Q_T^B + Q_T^I,\\
@@ -363,8 +491,8 @@ static double shelf_base_melt_rate(GivenTH::Constants c,
  * not, and cannot pick one of the three cases without computing the
  * basal melt rate first.
  *
- * This method tries to compute basal salinity that is consistent with
- * the corresponding basal melt rate. See the code for details.
+ * This method computes basal salinity that is consistent with the
+ * corresponding basal melt rate (see below).
  *
  * Once @f$ S_B @f$ is found by solving this quadratic equation, we can
  * compute the basal temperature using the parameterization for @f$
@@ -375,128 +503,8 @@ static double shelf_base_melt_rate(GivenTH::Constants c,
  *
  * @f[ w_b = -\frac{\partial h}{\partial t} = \frac{\gamma_S\, \rho_W\, (S^W - S^B)}{\rho_I\, S^B}. @f]
  *
- *
- * @param[in] constants model constants
- * @param[in] sea_water_salinity sea water salinity
- * @param[in] sea_water_potential_temperature sea water potential temperature
- * @param[in] thickness ice shelf thickness
- * @param[out] shelf_base_temperature_out resulting basal temperature
- * @param[out] shelf_base_melt_rate_out resulting basal melt rate
- *
- * @return 0 on success
- */
-void GivenTH::pointwise_update(const Constants &constants,
-                                 double sea_water_salinity,
-                                 double sea_water_potential_temperature,
-                                 double thickness,
-                                 double *shelf_base_temperature_out,
-                                 double *shelf_base_melt_rate_out) {
-
-  assert(thickness >= 0.0);
-
-  // This model works for sea water salinity in the range of [4, 40]
-  // psu. Ensure that input salinity is in this range.
-  const double
-    min_salinity = 4.0,
-    max_salinity = 40.0;
-
-  if (constants.limit_salinity_range == true) {
-    if (sea_water_salinity < min_salinity) {
-      sea_water_salinity = min_salinity;
-    } else if (sea_water_salinity > max_salinity) {
-      sea_water_salinity = max_salinity;
-    }
-  }
-
-  double basal_salinity = sea_water_salinity;
-  subshelf_salinity(constants, sea_water_salinity, sea_water_potential_temperature,
-                    thickness, &basal_salinity);
-
-  // Clip basal salinity so that we can use the freezing point
-  // temperature parameterization to recover shelf base temperature.
-  if (constants.limit_salinity_range == true) {
-    if (basal_salinity <= min_salinity) {
-      basal_salinity = min_salinity;
-    } else if (basal_salinity >= max_salinity) {
-      basal_salinity = max_salinity;
-    }
-  }
-
-  *shelf_base_temperature_out = melting_point_temperature(constants, basal_salinity, thickness);
-
-  *shelf_base_melt_rate_out = shelf_base_melt_rate(constants, sea_water_salinity, basal_salinity);
-
-  // no melt if there is no ice
-  if (thickness == 0.0) {
-    *shelf_base_melt_rate_out = 0.0;
-  }
-}
-
-
-/** @brief Compute the basal salinity and make sure that it is
- * consistent with the basal melt rate.
- *
- * @param[in] c constants
- * @param[in] sea_water_salinity sea water salinity
- * @param[in] sea_water_potential_temperature sea water potential temperature
- * @param[in] thickness ice shelf thickness
- * @param[out] shelf_base_salinity resulting shelf base salinity
- *
- * @return 0 on success
- */
-void GivenTH::subshelf_salinity(const Constants &c,
-                                            double sea_water_salinity,
-                                            double sea_water_potential_temperature,
-                                            double thickness,
-                                            double *shelf_base_salinity) {
-  double basal_salinity = sea_water_salinity;
-
-  // first, assume that there is melt at the shelf base:
-  {
-    subshelf_salinity_melt(c, sea_water_salinity, sea_water_potential_temperature,
-                           thickness, &basal_salinity);
-
-    double basal_melt_rate = shelf_base_melt_rate(c, sea_water_salinity, basal_salinity);
-
-    if (basal_melt_rate > 0.0) {
-      // computed basal melt rate is consistent with the assumption used
-      // to compute basal salinity
-      *shelf_base_salinity = basal_salinity;
-      return;
-    }
-  }
-
-  // Assuming that there is melt resulted in an inconsistent
-  // (salinity, melt_rate) pair. Assume that there is freeze-on at the base.
-  {
-    subshelf_salinity_freeze_on(c, sea_water_salinity, sea_water_potential_temperature,
-                                thickness, &basal_salinity);
-
-    double basal_melt_rate = shelf_base_melt_rate(c, sea_water_salinity, basal_salinity);
-
-    if (basal_melt_rate < 0.0) {
-      // computed basal melt rate is consistent with the assumption
-      // used to compute basal salinity
-      *shelf_base_salinity = basal_salinity;
-      return;
-    }
-  }
-
-  // Both assumptions (above) resulted in inconsistencies. Revert to
-  // the "diffusion-only" case, which may be less accurate, but is
-  // generic and is always consistent.
-  {
-    subshelf_salinity_diffusion_only(c, sea_water_salinity, sea_water_potential_temperature,
-                                     thickness, &basal_salinity);
-
-    *shelf_base_salinity = basal_salinity;
-  }
-}
-
-/** Compute basal salinity in the basal melt case.
- *
- * We use the parameterization of the temperature gradient from [@ref
- * Hellmeretal1998], equation 13:
+ * In the basal melt case we use the parameterization of the
+ * temperature gradient from [@ref Hellmeretal1998], equation 13:
  *
  * @f[ T_{\text{grad}} = -\Delta T\, \frac{\frac{\partial h}{\partial t}}{\kappa}, @f]
  *
@@ -504,10 +512,9 @@ void GivenTH::subshelf_salinity(const Constants &c,
  * temperature at the top of the ice column and its bottom:
  * @f$ \Delta T = T^S - T^B. @f$ With this parameterization, we have
  *
- * @f[ Q_T^I = \rho_I\, c_{pI}\, {\frac{\partial h}{\partial t}}\, (T^S - T^B). @f]
+ * @f[ Q_T^I = \rho_I\, c_{pI}\, {\frac{\partial h}{\partial t}}\, (T^S - T^B) @f]
  *
- * Then the coefficients of the quadratic equation for basal salinity
- * (see pointwise_update()) are
+ * and the coefficients of the quadratic equation for basal salinity are
  *
  * @f{align*}{
  * A &= a_{0}\,\gamma_S\,c_{pI}-b_{0}\,\gamma_T\,c_{pW}\\
@@ -516,56 +523,8 @@ void GivenTH::subshelf_salinity(const Constants &c,
  * C &= -\gamma_S\,S^W\,\left(L-c_{pI}\,\left(T^S-a_{2}\,h-a_{1}\right)\right)
  * @f}
  *
- * @param[in] c physical constants, stored here to avoid looking them up in a double for loop
- * @param[in] sea_water_salinity salinity of the ocean immediately adjacent to the shelf, [g/kg]
- * @param[in] sea_water_potential_temperature potential temperature of the sea water, [degrees Celsius]
- * @param[in] thickness thickness of the ice shelf, [meters]
- * @param[out] shelf_base_salinity resulting shelf base salinity
- *
- * @return 0 on success
- */
-void GivenTH::subshelf_salinity_melt(const Constants &c,
-                                                 double sea_water_salinity,
-                                                 double sea_water_potential_temperature,
-                                                 double thickness,
-                                                 double *shelf_base_salinity) {
-
-  const double
-    c_pI    = c.ice_specific_heat_capacity,
-    c_pW    = c.sea_water_specific_heat_capacity,
-    L       = c.water_latent_heat_fusion,
-    T_S     = c.shelf_top_surface_temperature,
-    S_W     = sea_water_salinity,
-    Theta_W = sea_water_potential_temperature;
-
-  // We solve a quadratic equation for Sb, the salinity at the shelf
-  // base.
-  //
-  // A*Sb^2 + B*Sb + C = 0
-  const double A = c.a[0] * c.gamma_S * c_pI - c.b[0] * c.gamma_T * c_pW;
-  const double B = (c.gamma_S * (L - c_pI * (T_S + c.a[0] * S_W - c.a[2] * thickness - c.a[1])) +
-                    c.gamma_T * c_pW * (Theta_W - c.b[2] * thickness - c.b[1]));
-  const double C = -c.gamma_S * S_W * (L - c_pI * (T_S - c.a[2] * thickness - c.a[1]));
-
-  double S1 = 0.0, S2 = 0.0;
-  const int n_roots = gsl_poly_solve_quadratic(A, B, C, &S1, &S2);
-
-  assert(n_roots > 0);
-  assert(S2 > 0.0);             // The bigger root should be positive.
-
-  *shelf_base_salinity = S2;
-}
-
-/** Compute basal salinity in the basal freeze-on case.
- *
- * In this case we assume that the temperature gradient at the shelf base is zero:
- *
- * @f[ T_{\text{grad}} = 0. @f]
- *
- * Please see pointwise_update() for details.
- *
- * In this case the coefficients of the quadratic equation for the
- * basal salinity are:
+ * In the basal freeze-on case we assume that the temperature gradient
+ * at the shelf base is zero, @f$ T_{\text{grad}} = 0, @f$ so
  *
  * @f{align*}{
  * A &= -b_{0}\,\gamma_T\,c_{pW} \\
@@ -573,107 +532,107 @@ void GivenTH::subshelf_salinity_melt(const Constants &c,
  * C &= -\gamma_S\,S^W\,L\\
  * @f}
  *
- * @param[in] c model constants
- * @param[in] sea_water_salinity sea water salinity
- * @param[in] sea_water_potential_temperature sea water temperature
- * @param[in] thickness ice shelf thickness
- * @param[out] shelf_base_salinity resulting basal salinity
+ * Cells are processed in blocks: the basal salinity is computed in
+ * the melt and the freeze-on regimes for all cells in a block (these
+ * loops have no branches), then the first regime consistent with the
+ * sign of the resulting melt rate is selected. If neither is
+ * consistent we revert to the "diffusion-only" case (see
+ * subshelf_salinity_diffusion_only()), which may be less accurate,
+ * but is generic and is always consistent.
  *
- * @return 0 on success
+ * @param[in] constants model constants
+ * @param[in] N number of cells
+ * @param[in] sea_water_salinity sea water salinity
+ * @param[in] sea_water_potential_temperature sea water potential temperature, degrees Celsius
+ * @param[in] ice_thickness ice shelf thickness
+ * @param[out] shelf_base_temperature_out resulting basal temperature, degrees Celsius
+ * @param[out] shelf_base_melt_rate_out resulting basal melt rate, m/s
  */
-void GivenTH::subshelf_salinity_freeze_on(const Constants &c,
-                                                      double sea_water_salinity,
-                                                      double sea_water_potential_temperature,
-                                                      double thickness,
-                                                      double *shelf_base_salinity) {
+void GivenTH::update_cells(const Constants &constants, unsigned int N,
+                           const double *sea_water_salinity,
+                           const double *sea_water_potential_temperature,
+                           const double *ice_thickness,
+                           double *shelf_base_temperature_out,
+                           double *shelf_base_melt_rate_out) {
+  const Constants &c = constants;
 
   const double
-    c_pW    = c.sea_water_specific_heat_capacity,
-    L       = c.water_latent_heat_fusion,
-    S_W     = sea_water_salinity,
-    Theta_W = sea_water_potential_temperature,
-    h       = thickness;
+    min_salinity = 4.0,
+    max_salinity = 40.0,
+    c_pI         = c.ice_specific_heat_capacity,
+    c_pW         = c.sea_water_specific_heat_capacity,
+    L            = c.water_latent_heat_fusion,
+    T_S          = c.shelf_top_surface_temperature;
+
+  // coefficients of x^2 in quadratic equations for the basal salinity (melt and
+  // freeze-on cases, see above)
+  const double
+    A_melt   = c.a[0] * c.gamma_S * c_pI - c.b[0] * c.gamma_T * c_pW,
+    A_freeze = -c.b[0] * c.gamma_T * c_pW;
 
-  // We solve a quadratic equation for Sb, the salinity at the shelf
-  // base.
-  //
-  // A*Sb^2 + B*Sb + C = 0
-  const double A = -c.b[0] * c.gamma_T * c_pW;
-  const double B = c.gamma_S * L + c.gamma_T * c_pW * (Theta_W - c.b[2] * h - c.b[1]);
-  const double C = -c.gamma_S * S_W * L;
+  const unsigned int block_size = 64;
+  double S_W[block_size], S_B[block_size];
+  bool diffusion_only[block_size];
 
-  double S1 = 0.0, S2 = 0.0;
-  const int n_roots = gsl_poly_solve_quadratic(A, B, C, &S1, &S2);
+  for (unsigned int start = 0; start < N; start += block_size) {
+    const unsigned int n = std::min(block_size, N - start);
 
-  assert(n_roots > 0);
-  assert(S2 > 0.0);             // The bigger root should be positive.
+    const double
+      *Theta_W = sea_water_potential_temperature + start,
+      *h       = ice_thickness + start;
 
-  *shelf_base_salinity = S2;
-}
+    for (unsigned int k = 0; k < n; ++k) {
+      S_W[k] = sea_water_salinity[start + k];
+    }
 
-/** @brief Compute basal salinity in the case of no basal melt and no
- * freeze-on, with the diffusion-only temperature distribution in the
- * ice column.
- *
- * In this case the temperature gradient at the base ([@ref
- * HollandJenkins1999], equation 21) is
- *
- * @f[ T_{\text{grad}} = \frac{\Delta T}{h}, @f]
- *
- * where @f$ h @f$ is the ice shelf thickness and @f$ \Delta T = T^S -
- * T^B @f$ is the difference between the temperature at the top and
- * the bottom of the shelf.
- *
- * In this case the coefficients of the quadratic equation for the basal salinity are:
- *
- * @f{align*}{
- * A &= - \frac{b_{0}\,\gamma_T\,h\,\rho_W\,c_{pW}-a_{0}\,\rho_I\,c_{pI}\,\kappa}{h\,\rho_W}\\
- * B &= \frac{\rho_I\,c_{pI}\,\kappa\,\left(T^S-a_{2}\,h-a_{1}\right)}{h\,\rho_W}
- +\gamma_S\,L+\gamma_T\,c_{pW}\,\left(\Theta^W-b_{2}\,h-b_{1}\right)\\
- * C &= -\gamma_S\,S^W\,L\\
- * @f}
- *
- * @param[in] c model constants
- * @param[in] sea_water_salinity sea water salinity
- * @param[in] sea_water_potential_temperature sea water potential temperature
- * @param[in] thickness ice shelf thickness
- * @param[out] shelf_base_salinity resulting basal salinity
- *
- * @return 0 on success
- */
-void GivenTH::subshelf_salinity_diffusion_only(const Constants &c,
-                                                           double sea_water_salinity,
-                                                           double sea_water_potential_temperature,
-                                                           double thickness,
-                                                           double *shelf_base_salinity) {
-  const double
-    c_pI    = c.ice_specific_heat_capacity,
-    c_pW    = c.sea_water_specific_heat_capacity,
-    L       = c.water_latent_heat_fusion,
-    T_S     = c.shelf_top_surface_temperature,
-    S_W     = sea_water_salinity,
-    Theta_W = sea_water_potential_temperature,
-    h       = thickness,
-    rho_W   = c.sea_water_density,
-    rho_I   = c.ice_density,
-    kappa   = c.ice_thermal_diffusivity;
+    if (c.limit_salinity_range == true) {
+      for (unsigned int k = 0; k < n; ++k) {
+        S_W[k] = std::min(std::max(S_W[k], min_salinity), max_salinity);
+      }
+    }
 
-  // We solve a quadratic equation for Sb, the salinity at the shelf
-  // base.
-  //
-  // A*Sb^2 + B*Sb + C = 0
-  const double A = -(c.b[0] * c.gamma_T * h * rho_W * c_pW - c.a[0] * rho_I * c_pI * kappa) / (h * rho_W);
-  const double B = ((rho_I * c_pI * kappa * (T_S - c.a[2] * h - c.a[1])) / (h * rho_W) +
-                    c.gamma_S * L + c.gamma_T * c_pW * (Theta_W - c.b[2] * h - c.b[1]));
-  const double C = -c.gamma_S * S_W * L;
+    for (unsigned int k = 0; k < n; ++k) {
+      const double
+        B_melt = (c.gamma_S * (L - c_pI * (T_S + c.a[0] * S_W[k] - c.a[2] * h[k] - c.a[1])) +
+                  c.gamma_T * c_pW * (Theta_W[k] - c.b[2] * h[k] - c.b[1])),
+        C_melt = -c.gamma_S * S_W[k] * (L - c_pI * (T_S - c.a[2] * h[k] - c.a[1])),
+        B_freeze = c.gamma_S * L + c.gamma_T * c_pW * (Theta_W[k] - c.b[2] * h[k] - c.b[1]),
+        C_freeze = -c.gamma_S * S_W[k] * L;
+
+      const double
+        S_melt   = bigger_root(A_melt, B_melt, C_melt),
+        S_freeze = bigger_root(A_freeze, B_freeze, C_freeze);
+
+      // use the first regime that is consistent with the sign of the melt rate
+      const bool
+        melt   = shelf_base_melt_rate(c, S_W[k], S_melt) > 0.0,
+        freeze = shelf_base_melt_rate(c, S_W[k], S_freeze) < 0.0;
+
+      S_B[k]            = melt ? S_melt : S_freeze;
+      diffusion_only[k] = not (melt or freeze);
+    }
 
-  double S1 = 0.0, S2 = 0.0;
-  const int n_roots = gsl_poly_solve_quadratic(A, B, C, &S1, &S2);
+    for (unsigned int k = 0; k < n; ++k) {
+      if (diffusion_only[k]) {
+        subshelf_salinity_diffusion_only(c, S_W[k], Theta_W[k], h[k], &S_B[k]);
+      }
+    }
 
-  assert(n_roots > 0);
-  assert(S2 > 0.0);             // The bigger root should be positive.
+    // Clip basal salinity so that we can use the freezing point
+    // temperature parameterization to recover shelf base temperature.
+    if (c.limit_salinity_range == true) {
+      for (unsigned int k = 0; k < n; ++k) {
+        S_B[k] = std::min(std::max(S_B[k], min_salinity), max_salinity);
+      }
+    }
 
-  *shelf_base_salinity = S2;
+    for (unsigned int k = 0; k < n; ++k) {
+      shelf_base_temperature_out[start + k] = melting_point_temperature(c, S_B[k], h[k]);
+      // no melt if there is no ice
+      shelf_base_melt_rate_out[start + k] = (h[k] == 0.0 ?
+                                             0.0 : shelf_base_melt_rate(c, S_W[k], S_B[k]));
+    }
+  }
 }
 
 } // end of namespace ocean
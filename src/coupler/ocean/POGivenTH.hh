@@ -19,6 +19,8 @@
 #ifndef _POGIVENTH_H_
 #define _POGIVENTH_H_
 
+#include <vector>
+
 #include "coupler/util/PGivenClimate.hh"
 #include "POModifier.hh"
 
@@ -73,30 +75,18 @@ private:
   IceModelVec2S m_shelfbtemp, m_shelfbmassflux;
   IceModelVec2T *m_theta_ocean, *m_salinity_ocean;
 
-  void pointwise_update(const Constants &constants,
-                        double sea_water_salinity,
-                        double sea_water_potential_temperature,
-                        double ice_thickness,
-                        double *shelf_base_temperature_out,
-                        double *shelf_base_melt_rate_out);
-
-  void subshelf_salinity(const Constants &constants,
-                         double sea_water_salinity,
-                         double sea_water_potential_temperature,
-                         double ice_thickness,
-                         double *shelf_base_salinity);
-
-  void subshelf_salinity_melt(const Constants &constants,
-                              double sea_water_salinity,
-                              double sea_water_potential_temperature,
-                              double ice_thickness,
-                              double *shelf_base_salinity);
+  //! indices of cells processed by update_cells()
+  std::vector<int> m_cell_i, m_cell_j;
+  //! inputs and outputs of update_cells(), one value per cell
+  std::vector<double> m_cell_salinity, m_cell_theta, m_cell_thickness,
+    m_cell_temperature, m_cell_melt_rate;
 
-  void subshelf_salinity_freeze_on(const Constants &constants,
-                                   double sea_water_salinity,
-                                   double sea_water_potential_temperature,
-                                   double ice_thickness,
-                                   double *shelf_base_salinity);
+  void update_cells(const Constants &constants, unsigned int N,
+                    const double *sea_water_salinity,
+                    const double *sea_water_potential_temperature,
+                    const double *ice_thickness,
+                    double *shelf_base_temperature_out,
+                    double *shelf_base_melt_rate_out);
 
   void subshelf_salinity_diffusion_only(const Constants &constants,
                                         double sea_water_salinity,
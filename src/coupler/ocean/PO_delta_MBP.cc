@@ -73,9 +73,19 @@ MaxTimestep Delta_MBP::max_timestep_impl(double t) {
 }
 
 void Delta_MBP::melange_back_pressure_fraction_impl(IceModelVec2S &result) {
-  input_model->melange_back_pressure_fraction(result);
+  compute_chain("melange_back_pressure_fraction",
+                &OceanModel::melange_back_pressure_fraction, result);
+}
 
-  result.shift((*offset)(m_t + 0.5*m_dt));
+bool Delta_MBP::transformation(const std::string &name, double &scale, double &shift) {
+  if (name == "melange_back_pressure_fraction") {
+    scale = 1.0;
+    shift = current_offset();
+  } else {
+    scale = 1.0;
+    shift = 0.0;
+  }
+  return true;
 }
 
 void Delta_MBP::add_vars_to_output_impl(const std::string &keyword, std::set<std::string> &result) {
@@ -44,6 +44,7 @@ protected:
                                      IO_Type nctype);
   virtual void init_impl();
   virtual void melange_back_pressure_fraction_impl(IceModelVec2S &result);
+  virtual bool transformation(const std::string &name, double &scale, double &shift);
 protected:
   SpatialVariableMetadata shelfbmassflux, shelfbtemp;
 };
@@ -82,6 +82,14 @@ void Delta_SL::sea_level_elevation_impl(double &result) {
   }
 }
 
+//! Sea level forcing does not change any of the fields.
+bool Delta_SL::transformation(const std::string &name, double &scale, double &shift) {
+  (void) name;
+  scale = 1.0;
+  shift = 0.0;
+  return true;
+}
+
 void Delta_SL::add_vars_to_output_impl(const std::string &keyword, std::set<std::string> &result) {
   input_model->add_vars_to_output(keyword, result);
 
@@ -38,6 +38,7 @@ protected:
                                      IO_Type nctype);
   virtual void init_impl();
   virtual void sea_level_elevation_impl(double &result);
+  virtual bool transformation(const std::string &name, double &scale, double &shift);
 protected:
   SpatialVariableMetadata shelfbmassflux, shelfbtemp;
 };
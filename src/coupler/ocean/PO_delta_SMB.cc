@@ -76,8 +76,18 @@ MaxTimestep Delta_SMB::max_timestep_impl(double t) {
 }
 
 void Delta_SMB::shelf_base_mass_flux_impl(IceModelVec2S &result) {
-  input_model->shelf_base_mass_flux(result);
-  offset_data(result);
+  compute_chain("shelf_base_mass_flux", &OceanModel::shelf_base_mass_flux, result);
+}
+
+bool Delta_SMB::transformation(const std::string &name, double &scale, double &shift) {
+  if (name == "shelf_base_mass_flux") {
+    scale = 1.0;
+    shift = current_offset();
+  } else {
+    scale = 1.0;
+    shift = 0.0;
+  }
+  return true;
 }
 
 void Delta_SMB::add_vars_to_output_impl(const std::string &keyword, std::set<std::string> &result) {
@@ -72,8 +72,18 @@ MaxTimestep Delta_T::max_timestep_impl(double t) {
 }
 
 void Delta_T::shelf_base_temperature_impl(IceModelVec2S &result) {
-  input_model->shelf_base_temperature(result);
-  offset_data(result);
+  compute_chain("shelf_base_temperature", &OceanModel::shelf_base_temperature, result);
+}
+
+bool Delta_T::transformation(const std::string &name, double &scale, double &shift) {
+  if (name == "shelf_base_temperature") {
+    scale = 1.0;
+    shift = current_offset();
+  } else {
+    scale = 1.0;
+    shift = 0.0;
+  }
+  return true;
 }
 
 void Delta_T::add_vars_to_output_impl(const std::string &keyword, std::set<std::string> &result) {
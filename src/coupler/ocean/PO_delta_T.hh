@@ -40,6 +40,7 @@ protected:
                                           IO_Type nctype);
   virtual void init_impl();
   virtual void shelf_base_temperature_impl(IceModelVec2S &result);
+  virtual bool transformation(const std::string &name, double &scale, double &shift);
 protected:
   SpatialVariableMetadata shelfbmassflux, shelfbtemp;
 };
@@ -39,13 +39,15 @@ Elevation::Elevation(IceGrid::ConstPtr g)
     m_climatic_mass_balance(m_sys, "climatic_mass_balance"),
     m_ice_surface_temp(m_sys, "ice_surface_temp")
 {
-  // empty
+  m_mass_flux.create(m_grid, "climatic_mass_balance", WITHOUT_GHOSTS);
+  m_temperature.create(m_grid, "ice_surface_temp", WITHOUT_GHOSTS);
 }
 
 void Elevation::init_impl() {
   bool m_limits_set = false;
 
   m_t = m_dt = GSL_NAN;  // every re-init restarts the clock
+  m_inputs.reset();
 
   m_log->message(2,
              "* Initializing the constant-in-time surface processes model Elevation. Setting...\n");
@@ -203,14 +205,32 @@ void Elevation::update_impl(double my_t, double my_dt)
 
 
 void Elevation::ice_surface_mass_flux_impl(IceModelVec2S &result) {
-  double dabdz = -m_M_min/(m_z_ELA - m_z_M_min);
-  double dacdz = m_M_max/(m_z_M_max - m_z_ELA);
+  compute_outputs();
+  result.copy_from(m_mass_flux);
+}
 
+void Elevation::ice_surface_temperature_impl(IceModelVec2S &result) {
+  compute_outputs();
+  result.copy_from(m_temperature);
+}
+
+//! Compute the climatic mass balance and the ice surface temperature if the surface elevation changed.
+void Elevation::compute_outputs() {
   // get access to ice upper surface elevation
   const IceModelVec2S *usurf = m_grid->variables().get_2d_scalar("surface_altitude");
 
+  m_inputs.add(*usurf);
+  if (not m_inputs.changed()) {
+    return;
+  }
+
+  double dabdz = -m_M_min/(m_z_ELA - m_z_M_min);
+  double dacdz = m_M_max/(m_z_M_max - m_z_ELA);
+  double dTdz = (m_T_max - m_T_min)/(m_z_T_max - m_z_T_min);
+
   IceModelVec::AccessList list;
-  list.add(result);
+  list.add(m_mass_flux);
+  list.add(m_temperature);
   list.add(*usurf);
   ParallelSection loop(m_grid->com);
   try {
@@ -219,52 +239,29 @@ void Elevation::ice_surface_mass_flux_impl(IceModelVec2S &result) {
 
       double z = (*usurf)(i, j);
       if (z < m_z_M_min) {
-        result(i, j) = m_M_limit_min;
+        m_mass_flux(i, j) = m_M_limit_min;
       }
       else if ((z >= m_z_M_min) && (z < m_z_ELA)) {
-        result(i, j) = dabdz * (z - m_z_ELA);
+        m_mass_flux(i, j) = dabdz * (z - m_z_ELA);
       }
       else if ((z >= m_z_ELA) && (z <= m_z_M_max)) {
-        result(i, j) = dacdz * (z - m_z_ELA);
+        m_mass_flux(i, j) = dacdz * (z - m_z_ELA);
       }
       else if (z > m_z_M_max) {
-        result(i, j) = m_M_limit_max;
+        m_mass_flux(i, j) = m_M_limit_max;
       }
       else {
         throw RuntimeError("Elevation::ice_surface_mass_flux: HOW DID I GET HERE?");
       }
-    }
-  } catch (...) {
-    loop.failed();
-  }
-  loop.check();
 
-  // convert from m/s ice equivalent to kg m-2 s-1:
-  result.scale(m_config->get_double("ice_density"));
-}
-
-void Elevation::ice_surface_temperature_impl(IceModelVec2S &result) {
-
-  const IceModelVec2S *usurf = m_grid->variables().get_2d_scalar("surface_altitude");
-
-  IceModelVec::AccessList list;
-  list.add(result);
-  list.add(*usurf);
-  double dTdz = (m_T_max - m_T_min)/(m_z_T_max - m_z_T_min);
-  ParallelSection loop(m_grid->com);
-  try {
-    for (Points p(*m_grid); p; p.next()) {
-      const int i = p.i(), j = p.j();
-
-      double z = (*usurf)(i, j);
       if (z <= m_z_T_min) {
-        result(i, j) = m_T_min;
+        m_temperature(i, j) = m_T_min;
       }
       else if ((z > m_z_T_min) && (z < m_z_T_max)) {
-        result(i, j) = m_T_min + dTdz * (z - m_z_T_min);
+        m_temperature(i, j) = m_T_min + dTdz * (z - m_z_T_min);
       }
       else if (z >= m_z_T_max) {
-        result(i, j) = m_T_max;
+        m_temperature(i, j) = m_T_max;
       }
       else {
         throw RuntimeError("Elevation::ice_surface_temperature: HOW DID I GET HERE?");
@@ -274,6 +271,9 @@ void Elevation::ice_surface_temperature_impl(IceModelVec2S &result) {
     loop.failed();
   }
   loop.check();
+
+  // convert from m/s ice equivalent to kg m-2 s-1:
+  m_mass_flux.scale(m_config->get_double("ice_density"));
 }
 
 void Elevation::add_vars_to_output_impl(const std::string &keyword, std::set<std::string> &result) {
@@ -22,6 +22,8 @@
 #include "coupler/PISMSurface.hh"
 #include "coupler/PISMAtmosphere.hh"
 #include "base/util/VariableMetadata.hh"
+#include "base/util/iceModelVec.hh"
+#include "coupler/util/PInputTracker.hh"
 
 namespace pism {
 namespace surface {
@@ -43,8 +45,12 @@ protected:
   virtual void add_vars_to_output_impl(const std::string &keyword, std::set<std::string> &result);
   virtual void define_variables_impl(const std::set<std::string> &vars,
                                      const PIO &nc, IO_Type nctype);
+  void compute_outputs();
 protected:
   SpatialVariableMetadata m_climatic_mass_balance, m_ice_surface_temp;
+  //! outputs, re-computed when the surface elevation changes
+  IceModelVec2S m_mass_flux, m_temperature;
+  InputTracker m_inputs;
   double m_T_min, m_T_max, m_z_T_min, m_z_T_max;
   double m_M_min, m_M_max, m_M_limit_min, m_M_limit_max, m_z_M_min, m_z_ELA, m_z_M_max;
 };
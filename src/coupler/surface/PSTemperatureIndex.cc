@@ -18,6 +18,7 @@
 
 #include <algorithm>            // std::min
 #include <cassert>
+#include <ctime>                // time(), used to seed the random number generator
 #include <gsl/gsl_math.h>
 
 #include "PSTemperatureIndex.hh"
@@ -76,9 +77,12 @@ TemperatureIndex::TemperatureIndex(IceGrid::ConstPtr g)
                                "Standard deviation data reference year", 0);
 
   if (m_randomized_repeatable) {
-    m_mbscheme = new PDDrandMassBalance(m_config, m_sys, true);
+    m_mbscheme = new PDDrandMassBalance(m_config, m_sys, 0);
   } else if (m_randomized) {
-    m_mbscheme = new PDDrandMassBalance(m_config, m_sys, false);
+    // seed with wall clock time in seconds; all processors have to use the same seed
+    unsigned int seed = time(0);
+    MPI_Bcast(&seed, 1, MPI_UNSIGNED, 0, m_grid->com);
+    m_mbscheme = new PDDrandMassBalance(m_config, m_sys, seed);
   } else {
     m_mbscheme = new PDDMassBalance(m_config, m_sys);
   }
@@ -276,7 +280,7 @@ void TemperatureIndex::update_impl(double my_t, double my_dt) {
   int Nseries = m_mbscheme->get_timeseries_length(my_dt);
 
   const double dtseries = my_dt / Nseries;
-  std::vector<double> ts(Nseries), T(Nseries), S(Nseries), P(Nseries), PDDs(Nseries);
+  std::vector<double> ts(Nseries), S(Nseries), PDDs(Nseries);
   for (int k = 0; k < Nseries; ++k) {
     ts[k] = my_t + k * dtseries;
   }
@@ -328,95 +332,112 @@ void TemperatureIndex::update_impl(double my_t, double my_dt) {
 
   const double ice_density = m_config->get_double("ice_density");
 
+  const int
+    xs = m_grid->xs(),
+    xm = m_grid->xm(),
+    ys = m_grid->ys(),
+    ym = m_grid->ym();
+
+  // air temperature and precipitation time series in a grid row
+  std::vector<double> T_row(ym * Nseries), P_row(ym * Nseries);
+
   ParallelSection loop(m_grid->com);
   try {
-    for (Points p(*m_grid); p; p.next()) {
-      const int i = p.i(), j = p.j();
+    // same order as Points
+    for (int i = xs; i < xs + xm; ++i) {
 
       // the temperature time series from the AtmosphereModel and its modifiers
-      m_atmosphere->temp_time_series(i, j, T);
+      m_atmosphere->temp_time_series_row(i, T_row);
 
       // the precipitation time series from AtmosphereModel and its modifiers
-      m_atmosphere->precip_time_series(i, j, P);
-
-      // interpolate temperature standard deviation time series
-      if (m_sd_file_set == true) {
-        m_air_temp_sd.interp(i, j, S);
-      } else {
-        for (int k = 0; k < Nseries; ++k) {
-          S[k] = m_air_temp_sd(i, j);
+      m_atmosphere->precip_time_series_row(i, P_row);
+
+      for (int j = ys; j < ys + ym; ++j) {
+        double
+          *T = &T_row[(j - ys) * Nseries],
+          *P = &P_row[(j - ys) * Nseries];
+
+        // interpolate temperature standard deviation time series
+        if (m_sd_file_set == true) {
+          m_air_temp_sd.interp(i, j, S);
+        } else {
+          for (int k = 0; k < Nseries; ++k) {
+            S[k] = m_air_temp_sd(i, j);
+          }
         }
-      }
 
-      if (m_faustogreve != NULL) {
-        // we have been asked to set mass balance parameters according to
-        //   formula (6) in [\ref Faustoetal2009]; they overwrite ddf set above
-        m_faustogreve->setDegreeDayFactors(i, j, (*surface_altitude)(i, j),
-                                           (*latitude)(i, j), (*longitude)(i, j), ddf);
-      }
-
-      // apply standard deviation lapse rate on top of prescribed values
-      if (sigmalapserate != 0.0) {
-        for (int k = 0; k < Nseries; ++k) {
-          S[k] += sigmalapserate * ((*latitude)(i,j) - sigmabaselat);
+        if (m_faustogreve != NULL) {
+          // we have been asked to set mass balance parameters according to
+          //   formula (6) in [\ref Faustoetal2009]; they overwrite ddf set above
+          m_faustogreve->setDegreeDayFactors(i, j, (*surface_altitude)(i, j),
+                                             (*latitude)(i, j), (*longitude)(i, j), ddf);
         }
-        m_air_temp_sd(i, j) = S[0]; // ensure correct SD reporting
-      }
 
-      // apply standard deviation param over ice if in use
-      if (m_sd_use_param && m.icy(i,j)) {
-        for (int k = 0; k < Nseries; ++k) {
-          S[k] = m_sd_param_a * (T[k] - 273.15) + m_sd_param_b;
-          if (S[k] < 0.0) {
-            S[k] = 0.0 ;
+        // apply standard deviation lapse rate on top of prescribed values
+        if (sigmalapserate != 0.0) {
+          for (int k = 0; k < Nseries; ++k) {
+            S[k] += sigmalapserate * ((*latitude)(i,j) - sigmabaselat);
           }
+          m_air_temp_sd(i, j) = S[0]; // ensure correct SD reporting
         }
-        m_air_temp_sd(i, j) = S[0]; // ensure correct SD reporting
-      }
 
-      // Use temperature time series, the "positive" threshhold, and
-      // the standard deviation of the daily variability to get the
-      // number of positive degree days (PDDs)
-      m_mbscheme->get_PDDs(&S[0], dtseries, &T[0], Nseries, &PDDs[0]);
-
-      // Use temperature time series to remove rainfall from precipitation
-      m_mbscheme->get_snow_accumulation(&P[0], // precipitation rate (input-output)
-                                        &T[0], // air temperature (input)
-                                        Nseries);
-
-      // Use degree-day factors, and number of PDDs, and the snow
-      // precipitation, to get surface mass balance (and diagnostics:
-      // accumulation, melt, runoff)
-      {
-        double next_snow_depth_reset = m_next_balance_year_start;
-        m_accumulation_rate(i,j)     = 0.0;
-        m_melt_rate(i,j)             = 0.0;
-        m_runoff_rate(i,j)           = 0.0;
-        m_climatic_mass_balance(i,j) = 0.0;
-        for (int k = 0; k < Nseries; ++k) {
-          if (ts[k] >= next_snow_depth_reset) {
-            m_snow_depth(i,j)       = 0.0;
-            while (next_snow_depth_reset <= ts[k]) {
-              next_snow_depth_reset = m_grid->ctx()->time()->increment_date(next_snow_depth_reset, 1);
+        // apply standard deviation param over ice if in use
+        if (m_sd_use_param && m.icy(i,j)) {
+          for (int k = 0; k < Nseries; ++k) {
+            S[k] = m_sd_param_a * (T[k] - 273.15) + m_sd_param_b;
+            if (S[k] < 0.0) {
+              S[k] = 0.0 ;
             }
           }
+          m_air_temp_sd(i, j) = S[0]; // ensure correct SD reporting
+        }
+
+        m_mbscheme->set_location(i, j, my_t);
+
+        // Use temperature time series, the "positive" threshhold, and
+        // the standard deviation of the daily variability to get the
+        // number of positive degree days (PDDs)
+        m_mbscheme->get_PDDs(&S[0], dtseries, T, Nseries, &PDDs[0]);
+
+        // Use temperature time series to remove rainfall from precipitation
+        m_mbscheme->get_snow_accumulation(P, // precipitation rate (input-output)
+                                          T, // air temperature (input)
+                                          Nseries);
+
+        // Use degree-day factors, and number of PDDs, and the snow
+        // precipitation, to get surface mass balance (and diagnostics:
+        // accumulation, melt, runoff)
+        {
+          double next_snow_depth_reset = m_next_balance_year_start;
+          m_accumulation_rate(i,j)     = 0.0;
+          m_melt_rate(i,j)             = 0.0;
+          m_runoff_rate(i,j)           = 0.0;
+          m_climatic_mass_balance(i,j) = 0.0;
+          for (int k = 0; k < Nseries; ++k) {
+            if (ts[k] >= next_snow_depth_reset) {
+              m_snow_depth(i,j)       = 0.0;
+              while (next_snow_depth_reset <= ts[k]) {
+                next_snow_depth_reset = m_grid->ctx()->time()->increment_date(next_snow_depth_reset, 1);
+              }
+            }
 
-          double accumulation     = P[k] * dtseries;
-          m_accumulation_rate(i,j) += accumulation;
+            double accumulation     = P[k] * dtseries;
+            m_accumulation_rate(i,j) += accumulation;
 
-          m_mbscheme->step(ddf, PDDs[k], accumulation,
-                           m_snow_depth(i,j), m_melt_rate(i,j), m_runoff_rate(i,j),
-                           m_climatic_mass_balance(i,j));
+            m_mbscheme->step(ddf, PDDs[k], accumulation,
+                             m_snow_depth(i,j), m_melt_rate(i,j), m_runoff_rate(i,j),
+                             m_climatic_mass_balance(i,j));
+          }
+          // convert from [m during the current time-step] to kg m-2 s-1
+          m_accumulation_rate(i,j)     *= (ice_density/m_dt);
+          m_melt_rate(i,j)             *= (ice_density/m_dt);
+          m_runoff_rate(i,j)           *= (ice_density/m_dt);
+          m_climatic_mass_balance(i,j) *= (ice_density/m_dt);
         }
-        // convert from [m during the current time-step] to kg m-2 s-1
-        m_accumulation_rate(i,j)     *= (ice_density/m_dt);
-        m_melt_rate(i,j)             *= (ice_density/m_dt);
-        m_runoff_rate(i,j)           *= (ice_density/m_dt);
-        m_climatic_mass_balance(i,j) *= (ice_density/m_dt);
-      }
 
-      if (m.ocean(i,j)) {
-        m_snow_depth(i,j) = 0.0;  // snow over the ocean does not stick
+        if (m.ocean(i,j)) {
+          m_snow_depth(i,j) = 0.0;  // snow over the ocean does not stick
+        }
       }
     }
   } catch (...) {
@@ -77,8 +77,18 @@ MaxTimestep Delta_T::max_timestep_impl(double t) {
 }
 
 void Delta_T::ice_surface_temperature_impl(IceModelVec2S &result) {
-  input_model->ice_surface_temperature(result);
-  offset_data(result);
+  compute_chain("ice_surface_temp", &SurfaceModel::ice_surface_temperature, result);
+}
+
+bool Delta_T::transformation(const std::string &name, double &scale, double &shift) {
+  if (name == "ice_surface_temp") {
+    scale = 1.0;
+    shift = current_offset();
+  } else {
+    scale = 1.0;
+    shift = 0.0;
+  }
+  return true;
 }
 
 void Delta_T::add_vars_to_output_impl(const std::string &keyword, std::set<std::string> &result) {
@@ -39,6 +39,7 @@ public:
 protected:
   virtual void init_impl();
   virtual void ice_surface_temperature_impl(IceModelVec2S &result);
+  virtual bool transformation(const std::string &name, double &scale, double &shift);
   virtual MaxTimestep max_timestep_impl(double t);
   virtual void write_variables_impl(const std::set<std::string> &vars, const PIO &nc);
   virtual void add_vars_to_output_impl(const std::string &keyword, std::set<std::string> &result);
@@ -16,9 +16,6 @@
 // along with PISM; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
-#include <ctime>  // for time(), used to initialize random number gen
-#include <gsl/gsl_rng.h>
-#include <gsl/gsl_randist.h>
 #include <cmath>                // for erfc() in CalovGreveIntegrand()
 #include <cassert>
 #include <algorithm>
@@ -37,6 +34,12 @@ LocalMassBalance::LocalMassBalance(Config::ConstPtr myconfig, units::System::Ptr
   // empty
 }
 
+void LocalMassBalance::set_location(int i, int j, double t) {
+  (void) i;
+  (void) j;
+  (void) t;
+}
+
 PDDMassBalance::PDDMassBalance(Config::ConstPtr config, units::System::Ptr system)
   : LocalMassBalance(config, system) {
   precip_as_snow     = m_config->get_boolean("interpret_precip_as_snow");
@@ -44,6 +47,29 @@ PDDMassBalance::PDDMassBalance(Config::ConstPtr config, units::System::Ptr syste
   Tmax               = m_config->get_double("air_temp_all_precip_as_rain");
   pdd_threshold_temp = m_config->get_double("pdd_positive_threshold_temp");
   refreeze_ice_melt  = m_config->get_boolean("pdd_refreeze_ice_melt");
+  m_use_table        = m_config->get_boolean("pdd_tabulate_integrand");
+
+  // The integrand is sigma * g(TacC / sigma), where g(z) = phi(z) +
+  // z * Phi(z) and phi and Phi are the standard normal density and
+  // distribution functions. We tabulate g and g' = Phi and use cubic
+  // Hermite interpolation; its error is at most dz^4 / 384 * max |g^(4)|
+  // = dz^4 / 384 * phi(0), i.e. 1.04e-11 for dz = 0.01. Outside of the
+  // table g(z) differs from max(z, 0) by less than phi(z_max) / z_max^2.
+  // So the absolute error is below 2e-11 * sigma (see
+  // pdd_integrand_table_test() in test/nosetests.py).
+  m_table_z_max = 8.0;
+  m_table_dz    = 0.01;
+
+  if (m_use_table) {
+    const unsigned int N = static_cast<unsigned int>(2.0 * m_table_z_max / m_table_dz + 0.5) + 1;
+    m_table_value.resize(N);
+    m_table_derivative.resize(N);
+    for (unsigned int n = 0; n < N; ++n) {
+      const double z = -m_table_z_max + n * m_table_dz;
+      m_table_value[n]      = CalovGreveIntegrand(1.0, z);
+      m_table_derivative[n] = 0.5 * erfc(-z / sqrt(2.0));
+    }
+  }
 }
 
 
@@ -87,6 +113,36 @@ double PDDMassBalance::CalovGreveIntegrand(double sigma, double TacC) {
 }
 
 
+//! Evaluate CalovGreveIntegrand() using the table built in the constructor.
+double PDDMassBalance::CalovGreveIntegrand_table(double sigma, double TacC) const {
+  if (sigma == 0) {
+    return std::max(TacC, 0.0);
+  }
+
+  const double z = TacC / sigma;
+
+  if (z <= -m_table_z_max) {
+    return 0.0;
+  } else if (z >= m_table_z_max) {
+    return TacC;
+  }
+
+  const double x = (z + m_table_z_max) / m_table_dz;
+  const unsigned int n = std::min(static_cast<unsigned int>(x),
+                                  static_cast<unsigned int>(m_table_value.size() - 2));
+  const double
+    t   = x - n,
+    t2  = t * t,
+    t3  = t2 * t,
+    h00 = 2.0 * t3 - 3.0 * t2 + 1.0,
+    h10 = t3 - 2.0 * t2 + t,
+    h01 = -2.0 * t3 + 3.0 * t2,
+    h11 = t3 - t2;
+
+  return sigma * (h00 * m_table_value[n] + h01 * m_table_value[n + 1] +
+                  m_table_dz * (h10 * m_table_derivative[n] + h11 * m_table_derivative[n + 1]));
+}
+
 //! Compute the expected number of positive degree days from the input temperature time-series.
 /**
  * Use the rectangle method for simplicity.
@@ -101,8 +157,14 @@ void PDDMassBalance::get_PDDs(double *S, double dt_series,
                               double *T, unsigned int N, double *PDDs) {
   const double h_days = dt_series / m_seconds_per_day;
 
-  for (unsigned int k = 0; k < N; ++k) {
-    PDDs[k] = h_days * CalovGreveIntegrand(S[k], T[k] - pdd_threshold_temp);
+  if (m_use_table) {
+    for (unsigned int k = 0; k < N; ++k) {
+      PDDs[k] = h_days * CalovGreveIntegrand_table(S[k], T[k] - pdd_threshold_temp);
+    }
+  } else {
+    for (unsigned int k = 0; k < N; ++k) {
+      PDDs[k] = h_days * CalovGreveIntegrand(S[k], T[k] - pdd_threshold_temp);
+    }
   }
 }
 
@@ -221,23 +283,19 @@ void PDDMassBalance::step(const DegreeDayFactors &ddf,
 
 
 /*!
-Initializes the random number generator (RNG).  The RNG is GSL's recommended default,
-which seems to be "mt19937" and is DIEHARD (whatever that means ...). Seed with
-wall clock time in seconds in non-repeatable case, and with 0 in repeatable case.
+ * The seed has to be the same on all processors. Use a fixed seed to get
+ * repeatable results.
  */
 PDDrandMassBalance::PDDrandMassBalance(Config::ConstPtr config, units::System::Ptr system,
-                                       bool repeatable)
-  : PDDMassBalance(config, system) {
-  pddRandGen = gsl_rng_alloc(gsl_rng_default);  // so pddRandGen != NULL now
-  gsl_rng_set(pddRandGen, repeatable ? 0 : time(0));
+                                       unsigned int seed)
+  : PDDMassBalance(config, system),
+    m_seed(seed), m_i(0), m_j(0), m_t(0.0) {
+  // empty
 }
 
 
 PDDrandMassBalance::~PDDrandMassBalance() {
-  if (pddRandGen != NULL) {
-    gsl_rng_free(pddRandGen);
-    pddRandGen = NULL;
-  }
+  // empty
 }
 
 
@@ -256,6 +314,78 @@ unsigned int PDDrandMassBalance::get_timeseries_length(double dt) {
   return std::max(static_cast<size_t>(ceil(dt / m_seconds_per_day)), (size_t)2);
 }
 
+void PDDrandMassBalance::set_location(int i, int j, double t) {
+  m_i = i;
+  m_j = j;
+  m_t = t;
+}
+
+//! Compute the high and low 32-bit words of the product of `a` and `b`.
+static inline void mulhilo(uint32_t a, uint32_t b, uint32_t &hi, uint32_t &lo) {
+  uint64_t product = (uint64_t)a * (uint64_t)b;
+  hi = (uint32_t)(product >> 32);
+  lo = (uint32_t)product;
+}
+
+//! The Philox-4x32-10 counter-based random number generator.
+/*!
+ * Maps the counter `ctr` and the key `key` to 128 random bits (stored in `ctr`).
+ *
+ * See J. K. Salmon, M. A. Moraes, R. O. Dror, and D. E. Shaw, "Parallel random
+ * numbers: as easy as 1, 2, 3", SC'11.
+ */
+static void philox4x32(uint32_t ctr[4], const uint32_t key[2]) {
+  const uint32_t
+    M0 = 0xD2511F53, M1 = 0xCD9E8D57,
+    W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+
+  uint32_t k0 = key[0], k1 = key[1];
+
+  for (int r = 0; r < 10; ++r) {
+    uint32_t hi0, lo0, hi1, lo1;
+    mulhilo(M0, ctr[0], hi0, lo0);
+    mulhilo(M1, ctr[2], hi1, lo1);
+
+    const uint32_t
+      c0 = hi1 ^ ctr[1] ^ k0,
+      c2 = hi0 ^ ctr[3] ^ k1;
+
+    ctr[0] = c0;
+    ctr[1] = lo1;
+    ctr[2] = c2;
+    ctr[3] = lo0;
+
+    k0 += W0;
+    k1 += W1;
+  }
+}
+
+/*!
+ * Returns a sample from the standard normal distribution corresponding to the
+ * current grid point and the time `t` (rounded down to whole seconds).
+ *
+ * Uses the Box-Muller transform; one of the two uniform deviates uses 53
+ * random bits so that the tails are not truncated.
+ */
+double PDDrandMassBalance::gaussian(double t) const {
+  const int64_t time_index = (int64_t)floor(t);
+
+  uint32_t
+    ctr[4] = {(uint32_t)((uint64_t)time_index & 0xFFFFFFFF),
+              (uint32_t)((uint64_t)time_index >> 32),
+              (uint32_t)m_i,
+              (uint32_t)m_j},
+    key[2] = {m_seed, 0};
+
+  philox4x32(ctr, key);
+
+  const double
+    u1 = ((ctr[0] >> 5) * 67108864.0 + (ctr[1] >> 6) + 0.5) / 9007199254740992.0, // (0, 1)
+    u2 = ctr[2] / 4294967296.0;                                                     // [0, 1)
+
+  return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
 /** 
  * Computes
  * \f[
@@ -274,7 +404,7 @@ void PDDrandMassBalance::get_PDDs(double *S, double dt_series,
 
   for (unsigned int k = 0; k < N; ++k) {
     // average temperature in k-th interval
-    double T_k = T[k] + gsl_ran_gaussian(pddRandGen, S[k]); // add random: N(0,sigma)
+    double T_k = T[k] + S[k] * gaussian(m_t + k * dt_series); // add random: N(0,sigma)
 
     if (T_k > pdd_threshold_temp) {
       PDDs[k] = h_days * (T_k - pdd_threshold_temp);
@@ -20,7 +20,8 @@
 #define __localMassBalance_hh
 
 
-#include <gsl/gsl_rng.h>
+#include <vector>
+#include <stdint.h>
 
 #include "base/util/iceModelVec.hh"  // only needed for FaustoGrevePDDObject
 
@@ -80,6 +81,11 @@ public:
   virtual void get_PDDs(double *S, double dt_series,
                         double *T, unsigned int N, double *PDDs) = 0;
 
+  //! Set the grid point and the start time of the time series passed to get_PDDs().
+  /*! Does nothing by default; used by schemes that need to know where and
+    when they are evaluated. `i`, `j` are global grid indices, `t` is in seconds. */
+  virtual void set_location(int i, int j, double t);
+
   /*! Remove rain from precipitation. */
   virtual void get_snow_accumulation(double *precip_rate, double *T,
                                      unsigned int N) = 0;
@@ -137,8 +143,15 @@ public:
                     double &cumulative_runoff,
                     double &cumulative_smb);
 
-protected:
+  // public so that the accuracy of the table can be tested
   double CalovGreveIntegrand(double sigma, double TacC);
+  double CalovGreveIntegrand_table(double sigma, double TacC) const;
+protected:
+
+  //! tabulated integrand (with sigma = 1) and its derivative as functions of TacC / sigma
+  std::vector<double> m_table_value, m_table_derivative;
+  double m_table_z_max, m_table_dz;
+  bool m_use_table;
 
   bool precip_as_snow,          //!< interpret all the precipitation as snow (no rain)
     refreeze_ice_melt;          //!< refreeze melted ice
@@ -150,8 +163,11 @@ protected:
 
 //! An alternative PDD implementation which simulates a random process to get the number of PDDs.
 /*!
-  Uses a GSL random number generator.  Significantly slower because new random numbers are
-  generated for each grid point.
+  Uses a counter-based random number generator (Philox-4x32-10, see [Salmon et al, 2011])
+  keyed on the seed, the global grid indices and the time (in whole seconds) of each
+  sample. Random numbers do not depend on the order in which grid points are visited, so
+  results are the same for any domain decomposition. Significantly slower because new
+  random numbers are generated for each grid point.
 
   The way the number of positive degree-days are used to produce a surface mass balance
   is identical to the base class PDDMassBalance.
@@ -164,15 +180,21 @@ class PDDrandMassBalance : public PDDMassBalance {
 
 public:
   PDDrandMassBalance(Config::ConstPtr myconfig, units::System::Ptr system,
-                     bool repeatable); //! repeatable==true to seed with zero every time.
+                     unsigned int seed);
   virtual ~PDDrandMassBalance();
 
   virtual unsigned int get_timeseries_length(double dt);
 
+  virtual void set_location(int i, int j, double t);
+
   virtual void get_PDDs(double *S, double dt_series,
                         double *T, unsigned int N, double *PDDs);
 protected:
-  gsl_rng *pddRandGen;
+  double gaussian(double t) const;
+
+  uint32_t m_seed;
+  int m_i, m_j;
+  double m_t;
 };
 
 
@@ -0,0 +1,102 @@
+// Copyright (C) 2015 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef _PINPUTTRACKER_H_
+#define _PINPUTTRACKER_H_
+
+#include <vector>
+
+#include "base/util/iceModelVec.hh"
+
+namespace pism {
+
+//! \brief Tracks inputs of a computation so that it can be skipped if
+//! they did not change.
+/*!
+ * Inputs are fields (identified by their addresses and state counters)
+ * and scalars (times, forcing record indices, parameters).
+ *
+ * Use it like this:
+ *
+ * @code
+ * m_inputs.add(*surface_altitude);
+ * m_inputs.add(*latitude);
+ * if (m_inputs.changed()) {
+ *   // re-compute outputs
+ * }
+ * @endcode
+ *
+ * The first call of changed() (and the first one after reset()) returns true.
+ *
+ * Code modifying a field that is used as an input has to call
+ * `inc_state_counter()` (most IceModelVec methods do this). Do not use
+ * fields that are modified element-by-element without doing this, such
+ * as the ice thickness, as inputs.
+ */
+class InputTracker {
+public:
+  InputTracker()
+    : m_valid(false) {
+    // empty
+  }
+
+  //! Add a field to the current list of inputs.
+  void add(const IceModelVec &input) {
+    m_fields.push_back(&input);
+    m_counters.push_back(input.get_state_counter());
+  }
+
+  //! Add a scalar to the current list of inputs.
+  void add(double input) {
+    m_values.push_back(input);
+  }
+
+  //! Compare current inputs to the ones used last time and start a new list.
+  bool changed() {
+    const bool result = (not m_valid or
+                         m_fields   != m_old_fields or
+                         m_counters != m_old_counters or
+                         m_values   != m_old_values);
+
+    m_old_fields.swap(m_fields);
+    m_old_counters.swap(m_counters);
+    m_old_values.swap(m_values);
+
+    m_fields.clear();
+    m_counters.clear();
+    m_values.clear();
+
+    m_valid = true;
+
+    return result;
+  }
+
+  //! Force re-computation during the next call of changed().
+  void reset() {
+    m_valid = false;
+  }
+private:
+  bool m_valid;
+  std::vector<const IceModelVec*> m_fields, m_old_fields;
+  std::vector<int> m_counters, m_old_counters;
+  std::vector<double> m_values, m_old_values;
+};
+
+} // end of namespace pism
+
+#endif /* _PINPUTTRACKER_H_ */
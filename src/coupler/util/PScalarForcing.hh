@@ -94,12 +94,82 @@ protected:
 
   //! Apply offset as an offset
   void offset_data(IceModelVec2S &result) {
-    result.shift((*offset)(Mod::m_t + 0.5*Mod::m_dt));
+    result.shift(current_offset());
   }
 
   //! Apply offset as a scaling factor
   void scale_data(IceModelVec2S &result) {
-    result.scale((*offset)(Mod::m_t + 0.5*Mod::m_dt));
+    result.scale(current_offset());
+  }
+
+  //! The value of the scalar forcing in the middle of the current time step.
+  double current_offset() {
+    return (*offset)(Mod::m_t + 0.5*Mod::m_dt);
+  }
+
+  //! Get the transformation \f$ x \mapsto \text{scale}\, x + \text{shift} \f$ this
+  //! modifier applies to the field `name`.
+  /*!
+   * Returns false if this modifier changes `name` in some other way (or
+   * if it does not describe its effect), which ends a fused chain (see
+   * compute_chain()). Derived classes override this to take part in fused
+   * evaluation.
+   */
+  virtual bool transformation(const std::string &name, double &scale, double &shift) {
+    (void) name;
+    scale = 1.0;
+    shift = 0.0;
+    return false;
+  }
+
+  //! Compute the field `name` using one pass over the grid per chain of scalar forcings.
+  /*!
+   * Walks down the chain of scalar forcing modifiers below this one, composing their
+   * transformations of `name`, gets `name` from the first model that is not such a
+   * modifier (using `method`) and applies the composed transformation to it.
+   *
+   * For example, with `-atmosphere ...,delta_P,frac_P,paleo_precip` the precipitation
+   * is scaled and shifted once instead of three times.
+   */
+  void compute_chain(const std::string &name,
+                     void (Model::*method)(IceModelVec2S &result),
+                     IceModelVec2S &result) {
+    double scale = 1.0, shift = 0.0;
+    if (not this->transformation(name, scale, shift)) {
+      throw RuntimeError::formatted("compute_chain(\"%s\") called by a modifier that"
+                                    " does not describe its effect on this field",
+                                    name.c_str());
+    }
+
+    Model *model = input;
+    PScalarForcing *m = dynamic_cast<PScalarForcing*>(model);
+    double s = 1.0, b = 0.0;
+    while (m != NULL and m->transformation(name, s, b)) {
+      // the transformation of m is applied before the one we have so far
+      shift += scale * b;
+      scale *= s;
+
+      model = m->input;
+      m = dynamic_cast<PScalarForcing*>(model);
+    }
+
+    (model->*method)(result);
+
+    if (scale == 1.0) {
+      if (shift != 0.0) {
+        result.shift(shift);
+      }
+    } else if (shift == 0.0) {
+      result.scale(scale);
+    } else {
+      // include ghosts to match IceModelVec::scale() and IceModelVec::shift()
+      IceModelVec::AccessList list(result);
+      for (PointsWithGhosts p(*Mod::m_grid, result.get_stencil_width()); p; p.next()) {
+        const int i = p.i(), j = p.j();
+        result(i, j) = scale * result(i, j) + shift;
+      }
+      result.inc_state_counter();
+    }
   }
 
   Model *input;
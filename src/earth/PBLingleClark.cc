@@ -25,6 +25,8 @@
 #include "base/util/error_handling.hh"
 #include "base/util/PISMVars.hh"
 #include "base/util/MaxTimestep.hh"
+#include "base/util/Context.hh"
+#include "base/util/Profiling.hh"
 
 namespace pism {
 namespace bed {
@@ -54,12 +56,26 @@ PBLingleClark::PBLingleClark(IceGrid::ConstPtr g)
     rank0.failed();
   }
   rank0.check();
+
+  // Vecs on processor 0 and the extended grid used by BedDeformLC
+  // are not IceModelVecs, so we have to account for them here.
+  m_memory_bytes = 0.0;
+  if (m_bdLC != NULL) {
+    m_memory_bytes = (5.0 * m_grid->Mx() * m_grid->My() * sizeof(double) +
+                      m_bdLC->allocated_bytes());
+  }
+
+  const Profiling &profiling = m_grid->ctx()->profiling();
+  m_memory_component = profiling.memory_component();
+  profiling.memory_allocated(m_memory_component, m_memory_bytes);
 }
 
 PBLingleClark::~PBLingleClark() {
   if (m_bdLC != NULL) {
     delete m_bdLC;
   }
+
+  m_grid->ctx()->profiling().memory_freed(m_memory_component, m_memory_bytes);
 }
 
 void PBLingleClark::init_with_inputs_impl(const IceModelVec2S &bed,
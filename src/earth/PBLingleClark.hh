@@ -57,6 +57,10 @@ protected:
   //! bed uplift
   petsc::Vec::Ptr m_upliftp0;
   BedDeformLC *m_bdLC;
+
+  //! memory used by Vecs on processor 0 and BedDeformLC (see Profiling::memory_allocated())
+  double m_memory_bytes;
+  std::string m_memory_component;
 };
 
 } // end of namespace bed
@@ -163,6 +163,18 @@ BedDeformLC::~BedDeformLC() {
   fftw_free(m_loadhat);
 }
 
+//! Number of bytes of working storage allocated by this object.
+double BedDeformLC::allocated_bytes() const {
+  const double
+    thin    = m_Mx * m_My,
+    fat     = m_Nx * m_Ny,
+    fat_bdy = m_Nxge * m_Nyge;
+
+  // m_Hdiff, m_dbedElastic; m_U, m_U_start, m_vleft, m_vright; m_lrmE;
+  // three FFTW arrays
+  return (2.0 * thin + 4.0 * fat + fat_bdy) * sizeof(double) + 3.0 * fat * sizeof(fftw_complex);
+}
+
 /**
  * Pre-compute coefficients used by the model.
  */
@@ -63,6 +63,8 @@ public:
   void uplift_init();
   void step(double dtyear, double yearFromStart);
 
+  double allocated_bytes() const;
+
 protected:
   void precompute_coefficients();
 protected:
@@ -0,0 +1,558 @@
+// Copyright (C) 2015 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+static char help[] =
+  "\nPISM_BENCH\n"
+  "  Micro-benchmarks of PISM's computational kernels, separate from IceModel.\n"
+  "  Uses a synthetic ice dome on a grid set using -Mx, -My, -Mz, -Lx, -Ly.\n"
+  "  Prints one line of JSON per kernel.\n\n";
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <vector>
+
+#include "base/enthalpyConverter.hh"
+#include "base/energy/enthSystem.hh"
+#include "base/stressbalance/PISMStressBalance.hh"
+#include "base/stressbalance/ShallowStressBalance.hh"
+#include "base/stressbalance/sia/SIAFD.hh"
+#include "base/stressbalance/ssa/SSAFD.hh"
+#include "base/stressbalance/ssa/SSAFEM.hh"
+#include "base/util/Context.hh"
+#include "base/util/GhostExchangeGroup.hh"
+#include "base/util/IceGrid.hh"
+#include "base/util/Mask.hh"
+#include "base/util/PISMConfigInterface.hh"
+#include "base/util/PISMTime.hh"
+#include "base/util/PISMVars.hh"
+#include "base/util/error_handling.hh"
+#include "base/util/iceModelVec.hh"
+#include "base/util/io/PIO.hh"
+#include "base/util/io/io_helpers.hh"
+#include "base/util/petscwrappers/PetscInitializer.hh"
+#include "base/util/pism_const.hh"
+#include "base/util/pism_options.hh"
+#include "coupler/surface/localMassBalance.hh"
+
+namespace pism {
+
+//! Measures the wall-clock time of a kernel (maximum over all processes).
+class Stopwatch {
+public:
+  Stopwatch(MPI_Comm com)
+    : m_com(com) {
+    MPI_Barrier(m_com);
+    m_start = MPI_Wtime();
+  }
+
+  double elapsed() const {
+    return GlobalMax(m_com, MPI_Wtime() - m_start);
+  }
+private:
+  MPI_Comm m_com;
+  double m_start;
+};
+
+/*!
+ * Print results of a benchmark as one line of JSON.
+ *
+ * @param[in] grid computational grid
+ * @param[in] kernel name of the kernel
+ * @param[in] N number of repetitions
+ * @param[in] time total time of `N` repetitions, in seconds
+ * @param[in] cells number of grid cells processed by one repetition
+ * @param[in] bytes number of bytes read and written by one repetition
+ */
+static void report(const IceGrid &grid, const std::string &kernel,
+                   unsigned int N, double time, double cells, double bytes) {
+  PetscErrorCode ierr = PetscPrintf(grid.com,
+                                    "{\"kernel\": \"%s\", \"Mx\": %d, \"My\": %d, \"Mz\": %d,"
+                                    " \"processes\": %d, \"repetitions\": %d, \"time\": %.6e,"
+                                    " \"cells_per_second\": %.6e, \"gb_per_second\": %.6e}\n",
+                                    kernel.c_str(), grid.Mx(), grid.My(), grid.Mz(),
+                                    grid.size(), N, time,
+                                    N * cells / time, N * bytes / time * 1e-9);
+  PISM_CHK(ierr, "PetscPrintf");
+}
+
+//! Number of bytes received by all processes during one ghost update.
+static double ghost_bytes(const IceGrid &grid, unsigned int width,
+                          unsigned int values_per_cell) {
+  const double
+    xm    = grid.xm(),
+    ym    = grid.ym(),
+    local = ((xm + 2 * width) * (ym + 2 * width) - xm * ym) * values_per_cell * sizeof(double);
+
+  return GlobalSum(grid.com, local);
+}
+
+//! Set up a dome with a Vialov profile and cold ice.
+static void set_dome(const IceGrid &grid, const EnthalpyConverter &EC,
+                     IceModelVec2S &bed, IceModelVec2S &thickness,
+                     IceModelVec2S &surface, IceModelVec2Int &mask,
+                     IceModelVec3 &enthalpy) {
+  const double
+    H0 = 3000.0,
+    R  = 0.8 * std::min(grid.Lx(), grid.Ly()),
+    T  = 253.15;
+
+  const unsigned int Mz = grid.Mz();
+  std::vector<double> E(Mz);
+
+  IceModelVec::AccessList list;
+  list.add(thickness);
+  list.add(mask);
+  list.add(enthalpy);
+
+  for (Points p(grid); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    const double r = sqrt(grid.x(i) * grid.x(i) + grid.y(j) * grid.y(j));
+
+    double H = 0.0;
+    if (r < R) {
+      H = H0 * pow(1.0 - pow(r / R, 4.0 / 3.0), 3.0 / 8.0);
+    }
+    thickness(i, j) = H;
+
+    mask(i, j) = H > 0.0 ? MASK_GROUNDED : MASK_ICE_FREE_BEDROCK;
+
+    for (unsigned int k = 0; k < Mz; ++k) {
+      const double depth = std::max(H - grid.z(k), 0.0);
+      E[k] = EC.enthalpy(T, 0.0, EC.pressure(depth));
+    }
+    enthalpy.set_column(i, j, &E[0]);
+  }
+
+  bed.set(0.0);
+  bed.update_ghosts();
+  thickness.update_ghosts();
+  mask.update_ghosts();
+  enthalpy.update_ghosts();
+
+  surface.copy_from(thickness);
+}
+
+//! Solve the enthalpy equation in all icy columns (see IceModel::enthalpyAndDrainageStep()).
+static unsigned int enthalpy_step(const IceGrid &grid, const Config &config,
+                                  EnthalpyConverter::Ptr EC, double dt,
+                                  const IceModelVec2S &thickness,
+                                  const IceModelVec3 &enthalpy,
+                                  const IceModelVec3 &u3,
+                                  const IceModelVec3 &v3,
+                                  const IceModelVec3 &w3,
+                                  const IceModelVec3 &strain_heating3) {
+  energy::enthSystemCtx system(grid.z(), "enth", grid.dx(), grid.dy(), dt,
+                               config, enthalpy, u3, v3, w3, strain_heating3, EC);
+
+  std::vector<double> Enthnew(system.z().size());
+
+  const double
+    dz              = system.dz(),
+    T_surface       = 253.15,
+    basal_heat_flux = 0.042;    // W m-2
+
+  IceModelVec::AccessList list;
+  list.add(thickness);
+  list.add(enthalpy);
+  list.add(u3);
+  list.add(v3);
+  list.add(w3);
+  list.add(strain_heating3);
+
+  unsigned int N_columns = 0;
+
+  ParallelSection loop(grid.com);
+  try {
+    for (Points p(grid); p; p.next()) {
+      const int i = p.i(), j = p.j();
+
+      const double H = thickness(i, j);
+      if (H <= 0.0) {
+        continue;
+      }
+
+      system.initThisColumn(i, j, false, H);
+
+      const double depth_ks = H - system.ks() * dz;
+      system.setDirichletSurface(EC->enthalpy_permissive(T_surface, 0.0,
+                                                         EC->pressure(depth_ks)));
+      system.setBasalHeatFlux(basal_heat_flux);
+
+      system.solveThisColumn(Enthnew);
+
+      N_columns += 1;
+    }
+  } catch (...) {
+    loop.failed();
+  }
+  loop.check();
+
+  return N_columns;
+}
+
+/*!
+ * Compute the surface mass balance using the PDD scheme (see
+ * surface::TemperatureIndex::update_impl()) with a synthetic seasonal
+ * cycle of the air temperature.
+ */
+static void pdd_step(const IceGrid &grid, const Config &config,
+                     surface::PDDMassBalance &pdd, double dt,
+                     const IceModelVec2S &surface,
+                     IceModelVec2S &snow_depth,
+                     IceModelVec2S &smb) {
+  const unsigned int N = pdd.get_timeseries_length(dt);
+  const double dt_series = dt / N;
+
+  surface::LocalMassBalance::DegreeDayFactors ddf;
+  ddf.snow         = config.get_double("pdd_factor_snow");
+  ddf.ice          = config.get_double("pdd_factor_ice");
+  ddf.refreezeFrac = config.get_double("pdd_refreeze");
+
+  const double
+    sigma     = config.get_double("pdd_std_dev"),
+    precip    = 0.5 / dt,       // 0.5 m (ice equivalent) per year
+    lapse     = 0.006,          // K / m
+    amplitude = 10.0;           // K
+
+  std::vector<double> T(N), P(N), S(N, sigma), PDDs(N);
+
+  IceModelVec::AccessList list;
+  list.add(surface);
+  list.add(snow_depth);
+  list.add(smb);
+
+  for (Points p(grid); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    for (unsigned int k = 0; k < N; ++k) {
+      T[k] = 278.15 - lapse * surface(i, j) - amplitude * cos(2.0 * M_PI * k / N);
+      P[k] = precip;
+    }
+
+    pdd.get_PDDs(&S[0], dt_series, &T[0], N, &PDDs[0]);
+    pdd.get_snow_accumulation(&P[0], &T[0], N);
+
+    double melt = 0.0, runoff = 0.0;
+    smb(i, j) = 0.0;
+    for (unsigned int k = 0; k < N; ++k) {
+      pdd.step(ddf, PDDs[k], P[k] * dt_series,
+               snow_depth(i, j), melt, runoff, smb(i, j));
+    }
+  }
+}
+
+} // end of namespace pism
+
+int main(int argc, char *argv[]) {
+
+  using namespace pism;
+  using namespace pism::stressbalance;
+
+  MPI_Comm com = MPI_COMM_WORLD;
+  petsc::Initializer petsc(argc, argv, help);
+  PetscErrorCode ierr;
+
+  com = PETSC_COMM_WORLD;
+
+  /* This explicit scoping forces destructors to be called before PetscFinalize() */
+  try {
+    Context::Ptr ctx = context_from_options(com, "pism_bench");
+    Config::Ptr config = ctx->config();
+    units::System::Ptr unit_system = ctx->unit_system();
+
+    config->set_boolean("compute_grain_size_using_age", false);
+
+    bool
+      usage_set = options::Bool("-usage", "print usage info"),
+      help_set  = options::Bool("-help", "print help info");
+    if (usage_set or help_set) {
+      ierr = PetscPrintf(com,
+                         "\n"
+                         "usage of PISM_BENCH:\n"
+                         "  run pism_bench -Mx <number> -My <number> -Mz <number> -N <number>\n"
+                         "                 -kernels <list> -o foo.nc\n"
+                         "\n"
+                         "  kernels: ghosts,ghost_group,sia,ssafd,ssafem,enthalpy,pdd,netcdf\n"
+                         "\n"
+                         "  'cells_per_second' uses the number of grid cells (columns for 2D\n"
+                         "  kernels) processed; 'gb_per_second' uses sizes of input and output\n"
+                         "  fields (received ghost values for ghost updates), i.e. it is a\n"
+                         "  lower bound of the memory traffic.\n"
+                         "\n");
+      PISM_CHK(ierr, "PetscPrintf");
+    }
+
+    options::Integer N("-N", "Number of repetitions of each kernel", 10);
+    options::StringSet kernels("-kernels", "Comma-separated list of kernels to run",
+                               "ghosts,ghost_group,sia,ssafd,ssafem,enthalpy,pdd,netcdf");
+    options::String output_file("-o", "Set the output file name", "pism_bench.nc");
+
+    if (N < 1) {
+      throw RuntimeError::formatted("-N %d is invalid (need at least one repetition)",
+                                    (int)N);
+    }
+
+    GridParameters P(config);
+    P.Lx = 900e3;
+    P.Ly = P.Lx;
+    P.horizontal_size_from_options();
+
+    double Lz = 4000.0;
+    options::Integer Mz("-Mz", "Number of vertical grid levels", 41);
+
+    P.z = IceGrid::compute_vertical_levels(Lz, Mz, EQUAL);
+    P.ownership_ranges_from_options(ctx->size());
+
+    IceGrid::Ptr grid(new IceGrid(ctx, P));
+
+    EnthalpyConverter::Ptr EC(new ColdEnthalpyConverter(*config));
+
+    const int WIDE_STENCIL = config->get_double("grid_max_stencil_width");
+
+    Vars &vars = grid->variables();
+
+    IceModelVec2S bed_topography, ice_surface_elevation, ice_thickness, tauc,
+      melange_back_pressure, snow_depth, smb;
+    IceModelVec2Int mask;
+    IceModelVec3 enthalpy;
+
+    bed_topography.create(grid, "topg", WITH_GHOSTS, WIDE_STENCIL);
+    bed_topography.set_attrs("model_state", "bedrock surface elevation",
+                             "m", "bedrock_altitude");
+    vars.add(bed_topography);
+
+    ice_surface_elevation.create(grid, "usurf", WITH_GHOSTS, WIDE_STENCIL);
+    ice_surface_elevation.set_attrs("diagnostic", "ice upper surface elevation",
+                                    "m", "surface_altitude");
+    vars.add(ice_surface_elevation);
+
+    ice_thickness.create(grid, "thk", WITH_GHOSTS, WIDE_STENCIL);
+    ice_thickness.set_attrs("model_state", "land ice thickness",
+                            "m", "land_ice_thickness");
+    vars.add(ice_thickness);
+
+    mask.create(grid, "mask", WITH_GHOSTS, WIDE_STENCIL);
+    mask.set_attrs("model_state", "grounded_dragging_floating integer mask",
+                   "", "");
+    vars.add(mask);
+
+    tauc.create(grid, "tauc", WITH_GHOSTS, WIDE_STENCIL);
+    tauc.set_attrs("diagnostic", "yield stress for basal till (plastic or pseudo-plastic model)",
+                   "Pa", "");
+    tauc.set(2e5);
+    vars.add(tauc);
+
+    enthalpy.create(grid, "enthalpy", WITH_GHOSTS, WIDE_STENCIL);
+    enthalpy.set_attrs("model_state",
+                       "ice enthalpy (includes sensible heat, latent heat, pressure)",
+                       "J kg-1", "");
+    vars.add(enthalpy);
+
+    melange_back_pressure.create(grid, "melange_back_pressure", WITHOUT_GHOSTS);
+    melange_back_pressure.set_attrs("boundary_condition",
+                                    "melange back pressure fraction", "", "");
+    melange_back_pressure.set(0.0);
+
+    snow_depth.create(grid, "snow_depth", WITHOUT_GHOSTS);
+    snow_depth.set_attrs("diagnostic", "snow cover depth", "m", "");
+    snow_depth.set(0.0);
+
+    smb.create(grid, "climatic_mass_balance", WITHOUT_GHOSTS);
+    smb.set_attrs("diagnostic", "surface mass balance", "m", "");
+
+    set_dome(*grid, *EC, bed_topography, ice_thickness, ice_surface_elevation,
+             mask, enthalpy);
+
+    const double
+      cells_2d  = grid->Mx() * grid->My(),
+      cells_3d  = cells_2d * grid->Mz(),
+      bytes_2d  = cells_2d * sizeof(double),
+      bytes_3d  = cells_3d * sizeof(double),
+      dt        = units::convert(unit_system, 1.0, "year", "seconds");
+
+    std::set<std::string> K = kernels;
+
+    // Ghost updates of fields that did not change are skipped, so the
+    // ghost kernels mark fields as modified before each update.
+    if (K.find("ghosts") != K.end()) {
+      {
+        Stopwatch timer(com);
+        for (int k = 0; k < N; ++k) {
+          ice_thickness.inc_state_counter();
+          ice_thickness.update_ghosts();
+        }
+        report(*grid, "ghosts_2d", N, timer.elapsed(),
+               cells_2d, ghost_bytes(*grid, WIDE_STENCIL, 1));
+      }
+      {
+        Stopwatch timer(com);
+        for (int k = 0; k < N; ++k) {
+          enthalpy.inc_state_counter();
+          enthalpy.update_ghosts();
+        }
+        report(*grid, "ghosts_3d", N, timer.elapsed(),
+               cells_3d, ghost_bytes(*grid, WIDE_STENCIL, grid->Mz()));
+      }
+    }
+
+    if (K.find("ghost_group") != K.end()) {
+      const double bytes = ghost_bytes(*grid, WIDE_STENCIL, 3);
+      {
+        Stopwatch timer(com);
+        for (int k = 0; k < N; ++k) {
+          ice_thickness.inc_state_counter();
+          ice_surface_elevation.inc_state_counter();
+          bed_topography.inc_state_counter();
+          ice_thickness.update_ghosts();
+          ice_surface_elevation.update_ghosts();
+          bed_topography.update_ghosts();
+        }
+        report(*grid, "ghosts_separate", N, timer.elapsed(), 3 * cells_2d, bytes);
+      }
+      {
+        GhostExchangeGroup group(grid);
+        group.add(ice_thickness);
+        group.add(ice_surface_elevation);
+        group.add(bed_topography);
+        // allocate the buffer before timing
+        group.update();
+
+        Stopwatch timer(com);
+        for (int k = 0; k < N; ++k) {
+          ice_thickness.inc_state_counter();
+          ice_surface_elevation.inc_state_counter();
+          bed_topography.inc_state_counter();
+          group.update();
+        }
+        report(*grid, "ghosts_group", N, timer.elapsed(), 3 * cells_2d, bytes);
+      }
+    }
+
+    // The SIA is also needed to compute inputs of the enthalpy kernel.
+    StressBalance stress_balance(grid, new ZeroSliding(grid, EC), new SIAFD(grid, EC));
+    stress_balance.init();
+
+    if (K.find("sia") != K.end()) {
+      Stopwatch timer(com);
+      for (int k = 0; k < N; ++k) {
+        stress_balance.update(false, 0.0, melange_back_pressure);
+      }
+      // inputs: thickness, surface elevation, bed elevation, mask,
+      // enthalpy; outputs: three components of the velocity and the
+      // strain heating
+      report(*grid, "sia", N, timer.elapsed(),
+             cells_3d, 4 * bytes_2d + 5 * bytes_3d);
+    } else if (K.find("enthalpy") != K.end()) {
+      stress_balance.update(false, 0.0, melange_back_pressure);
+    }
+
+    if (K.find("ssafd") != K.end()) {
+      SSAFD ssa(grid, EC);
+      ssa.init();
+
+      Stopwatch timer(com);
+      for (int k = 0; k < N; ++k) {
+        ssa.update(false, melange_back_pressure);
+      }
+      // inputs: thickness, surface elevation, bed elevation, mask,
+      // tauc, enthalpy; output: two components of the velocity
+      report(*grid, "ssafd", N, timer.elapsed(),
+             cells_2d, 7 * bytes_2d + bytes_3d);
+    }
+
+    if (K.find("ssafem") != K.end()) {
+      SSAFEM ssa(grid, EC);
+      ssa.init();
+
+      Stopwatch timer(com);
+      for (int k = 0; k < N; ++k) {
+        ssa.update(false, melange_back_pressure);
+      }
+      // same inputs and outputs as SSAFD
+      report(*grid, "ssafem", N, timer.elapsed(),
+             cells_2d, 7 * bytes_2d + bytes_3d);
+    }
+
+    if (K.find("enthalpy") != K.end()) {
+      unsigned int N_columns = 0;
+
+      Stopwatch timer(com);
+      for (int k = 0; k < N; ++k) {
+        N_columns = enthalpy_step(*grid, *config, EC, dt, ice_thickness, enthalpy,
+                                  stress_balance.velocity_u(),
+                                  stress_balance.velocity_v(),
+                                  stress_balance.velocity_w(),
+                                  stress_balance.volumetric_strain_heating());
+      }
+      const double cells = GlobalSum(com, N_columns) * grid->Mz();
+      // inputs: enthalpy, three components of the velocity, strain heating
+      report(*grid, "enthalpy", N, timer.elapsed(),
+             cells, 5 * cells * sizeof(double));
+    }
+
+    if (K.find("pdd") != K.end()) {
+      surface::PDDMassBalance pdd(config, unit_system);
+
+      Stopwatch timer(com);
+      for (int k = 0; k < N; ++k) {
+        pdd_step(*grid, *config, pdd, dt, ice_surface_elevation, snow_depth, smb);
+      }
+      // input: surface elevation; outputs: snow depth, SMB
+      report(*grid, "pdd", N, timer.elapsed(), cells_2d, 3 * bytes_2d);
+    }
+
+    if (K.find("netcdf") != K.end()) {
+      {
+        PIO pio(grid->com, config->get_string("output_format"));
+
+        pio.open(output_file, PISM_READWRITE_MOVE);
+        io::define_time(pio, config->get_string("time_dimension_name"),
+                        grid->ctx()->time()->calendar(),
+                        grid->ctx()->time()->CF_units_string(),
+                        unit_system);
+        io::append_time(pio, config->get_string("time_dimension_name"), 0.0);
+        pio.close();
+      }
+      {
+        Stopwatch timer(com);
+        for (int k = 0; k < N; ++k) {
+          ice_thickness.write(output_file);
+          enthalpy.write(output_file);
+        }
+        report(*grid, "netcdf_write", N, timer.elapsed(),
+               cells_2d + cells_3d, bytes_2d + bytes_3d);
+      }
+      {
+        Stopwatch timer(com);
+        for (int k = 0; k < N; ++k) {
+          ice_thickness.read(output_file, 0);
+          enthalpy.read(output_file, 0);
+        }
+        report(*grid, "netcdf_read", N, timer.elapsed(),
+               cells_2d + cells_3d, bytes_2d + bytes_3d);
+      }
+    }
+  }
+  catch (...) {
+    handle_fatal_errors(com);
+  }
+
+  return 0;
+}
@@ -51,6 +51,9 @@
 #include "base/util/Context.hh"
 #include "base/util/Logger.hh"
 #include "base/util/Profiling.hh"
+#include "base/util/GhostExchangeGroup.hh"
+#include "base/util/CellList.hh"
+#include "base/calving/PISMFrontIndex.hh"
 %}
 
 // Include petsc4py.i so that we get support for automatic handling of PetscErrorCode return values
@@ -223,6 +226,14 @@
 /* IceModelVec uses IceGrid and VariableMetadata, so they have to be wrapped first. */
 %include pism_IceModelVec.i
 
+/* GhostExchangeGroup uses IceModelVec. */
+%include "base/util/GhostExchangeGroup.hh"
+
+/* CellList and its iterator are used by C++ kernels; Python only needs the list size. */
+%ignore pism::CellListPoints;
+%include "base/util/CellList.hh"
+%include "base/calving/PISMFrontIndex.hh"
+
 /* pism::Vars uses IceModelVec, so IceModelVec has to be wrapped first. */
 %include pism_Vars.i
 
@@ -263,3 +274,10 @@
 %include pism_inverse.i
 
 %include pism_ocean.i
+
+%include pism_atmosphere.i
+
+%{
+#include "coupler/surface/localMassBalance.hh"
+%}
+%include "coupler/surface/localMassBalance.hh"
@@ -0,0 +1,46 @@
+%{
+#include "coupler/atmosphere/PAYearlyCycle.hh"
+#include "coupler/atmosphere/PASeariseGreenland.hh"
+%}
+
+/* The *_time_series*() methods fill pre-allocated arrays, which does
+ * not work with the std::vector<double> OUTPUT typemap. Use the
+ * versions defined below instead. */
+%ignore pism::atmosphere::AtmosphereModel::temp_time_series(int, int, std::vector<double> &);
+%ignore pism::atmosphere::AtmosphereModel::precip_time_series(int, int, std::vector<double> &);
+%ignore pism::atmosphere::AtmosphereModel::temp_time_series_row(int, std::vector<double> &);
+%ignore pism::atmosphere::AtmosphereModel::precip_time_series_row(int, std::vector<double> &);
+
+%extend pism::atmosphere::AtmosphereModel
+{
+  // N is the number of times passed to init_timeseries()
+  std::vector<double> temp_time_series(int i, int j, int N) {
+    std::vector<double> result(N);
+    $self->temp_time_series(i, j, result);
+    return result;
+  }
+
+  std::vector<double> precip_time_series(int i, int j, int N) {
+    std::vector<double> result(N);
+    $self->precip_time_series(i, j, result);
+    return result;
+  }
+
+  std::vector<double> temp_time_series_row(int i, int N) {
+    std::vector<double> result($self->grid()->ym() * N);
+    $self->temp_time_series_row(i, result);
+    return result;
+  }
+
+  std::vector<double> precip_time_series_row(int i, int N) {
+    std::vector<double> result($self->grid()->ym() * N);
+    $self->precip_time_series_row(i, result);
+    return result;
+  }
+}
+
+%include "coupler/PISMAtmosphere.hh"
+%include "coupler/atmosphere/PAYearlyCycle.hh"
+
+%rename(AtmosphereSeaRISEGreenland) pism::atmosphere::SeaRISEGreenland;
+%include "coupler/atmosphere/PASeariseGreenland.hh"
@@ -791,3 +791,421 @@ def po_constant_test():
         assert np.fabs(mass_flux_1[0, 0] - M * rho) < 1e-16
         assert np.fabs(mass_flux_2[0, 0] - M * rho) < 1e-16
 
+
+def timeseries_find_test():
+    """Test that the interval lookup in Timeseries gives the same results
+    as a binary search regardless of the order of queries."""
+    import bisect
+    import random
+
+    grid = create_dummy_grid()
+
+    N = 100
+    random.seed(1)
+    bounds = [0.0]
+    values = []
+    for k in range(N):
+        bounds.append(bounds[-1] + random.uniform(0.5, 2.0))
+        values.append(random.uniform(-1.0, 1.0))
+
+    ts = PISM.Timeseries(grid, "delta_T", "time")
+    for k in range(N):
+        ts.append(values[k], bounds[k], bounds[k + 1])
+
+    # time bounds as stored by Timeseries::append()
+    time_bounds = []
+    for k in range(N):
+        time_bounds += [bounds[k], bounds[k + 1]]
+
+    def expected(t):
+        "Value at t found using a binary search (std::lower_bound)."
+        i = bisect.bisect_left(time_bounds, t)
+        if i == len(time_bounds):
+            return values[-1]
+        if i == 0:
+            return values[0]
+        return values[(i - 1) / 2]
+
+    # interval ends, points inside intervals and out-of-range queries
+    times = bounds + [0.5 * (bounds[k] + bounds[k + 1]) for k in range(N)]
+    times += [bounds[0] - 1.0, bounds[-1] + 1.0]
+    times += [random.uniform(bounds[0] - 1.0, bounds[-1] + 1.0) for k in range(1000)]
+
+    increasing = sorted(times)
+    decreasing = increasing[::-1]
+    shuffled = list(times)
+    random.shuffle(shuffled)
+    # short steps back and forth around the cursor
+    wiggle = []
+    for k in range(len(increasing) - 2):
+        wiggle += [increasing[k + 2], increasing[k], increasing[k + 1]]
+
+    for queries in [increasing, decreasing, shuffled, wiggle]:
+        for t in queries:
+            assert ts(t) == expected(t)
+
+    # evaluate() and repeated calls of operator() agree
+    result = PISM.DoubleVector()
+    ts.evaluate(PISM.DoubleVector(shuffled), result)
+    for k, t in enumerate(shuffled):
+        assert result[k] == expected(t)
+
+def time_calendar_year_cache_test():
+    """Test that cached beginnings of years in Time_Calendar give the same
+    results as direct calendar computations regardless of the order of
+    queries."""
+    import random
+
+    com = PISM.PETSc.COMM_WORLD
+    system = PISM.UnitSystem("")
+
+    logger = PISM.Logger(com, 2)
+
+    config = PISM.DefaultConfig(com, "pism_config", "-config", system)
+    config.init_with_default(logger)
+
+    random.seed(1)
+
+    for calendar in ["gregorian", "julian"]:
+        config.set_string("calendar", calendar)
+        config.set_string("reference_date", "1-1-1")
+
+        time = PISM.time_from_options(com, config, system)
+
+        # Uncached references: date() and increment_date() call calcalcs
+        # directly, and the time 0 corresponds to 1-1-1 00:00:00.
+        def year(T):
+            return int(time.date(T).split("-")[0])
+
+        def year_start(Y):
+            return time.increment_date(0.0, Y - 1)
+
+        # years in the pre-computed table, years the table is extended to
+        # and years too far from the table to be cached
+        years = range(1, 3000, 7) + range(15000, 15100)
+        times = []
+        for Y in years:
+            s = year_start(Y)
+            times += [s, s - 1.0, s + 1.0, s - 3600.0, s + 3600.0, s - 3601.0, s + 3601.0]
+            times.append(random.uniform(s, year_start(Y + 1)))
+        # skip times before the reference date (year 0 does not exist)
+        times = [T for T in times if T >= 0.0]
+
+        increasing = sorted(times)
+        decreasing = increasing[::-1]
+        shuffled = list(times)
+        random.shuffle(shuffled)
+
+        for queries in [shuffled, decreasing, increasing]:
+            for T in queries:
+                Y = year(T)
+                start = year_start(Y)
+                next_start = year_start(Y + 1)
+
+                assert time.calendar_year_start(T) == start
+                assert time.year_fraction(T) == (T - start) / (next_start - start)
+
+        # times of beginnings of years within the run
+        expected = [year_start(Y) for Y in range(year(time.start()), year(time.end()) + 2)]
+        expected = [t for t in expected if time.start() <= t <= time.end()]
+        assert time.parse_times("yearly") == expected
+
+def ghost_exchange_group_test():
+    """Test that GhostExchangeGroup gives the same ghost values as separate
+    update_ghosts() calls for a mix of 2D and 3D fields."""
+    grid = create_dummy_grid()
+    W = 1                       # stencil width
+
+    def create_fields(suffix):
+        a = PISM.IceModelVec3()
+        a.create(grid, "a" + suffix, PISM.WITH_GHOSTS, W)
+        b = PISM.IceModelVec3()
+        b.create(grid, "b" + suffix, PISM.WITH_GHOSTS, W)
+        c = PISM.IceModelVec2S()
+        c.create(grid, "c" + suffix, PISM.WITH_GHOSTS, W)
+        d = PISM.IceModelVec2V()
+        d.create(grid, "d" + suffix, PISM.WITH_GHOSTS, W)
+        return [a, b, c, d]
+
+    Mz = grid.Mz()
+
+    def fill(fields):
+        a, b, c, d = fields
+        with PISM.vec.Access(nocomm=fields):
+            # invalid values in ghosts
+            for (i, j) in grid.points_with_ghosts(W):
+                for k in range(Mz):
+                    a[i, j, k] = -1.0
+                    b[i, j, k] = -2.0
+                c[i, j] = -3.0
+                d[i, j] = [-4.0, -5.0]
+            for (i, j) in grid.points():
+                for k in range(Mz):
+                    a[i, j, k] = i + 1000.0 * j + 1e6 * k
+                    b[i, j, k] = -(i + 1000.0 * j + 1e6 * k)
+                c[i, j] = 0.5 * (i + 1000.0 * j)
+                d[i, j] = [float(i), float(j)]
+
+    group_fields = create_fields("_group")
+    separate_fields = create_fields("_separate")
+    fill(group_fields)
+    fill(separate_fields)
+
+    group = PISM.GhostExchangeGroup(grid)
+    for f in group_fields:
+        group.add(f)
+    group.update()
+
+    for f in separate_fields:
+        f.update_ghosts()
+
+    a1, b1, c1, d1 = group_fields
+    a2, b2, c2, d2 = separate_fields
+    with PISM.vec.Access(nocomm=group_fields + separate_fields):
+        for (i, j) in grid.points_with_ghosts(W):
+            for k in range(Mz):
+                assert a1[i, j, k] == a2[i, j, k]
+                assert b1[i, j, k] == b2[i, j, k]
+            assert c1[i, j] == c2[i, j]
+            assert d1[i, j].u == d2[i, j].u
+            assert d1[i, j].v == d2[i, j].v
+
+def front_index_test():
+    """Test that calving::FrontIndex re-builds its list of cells near the
+    ice margin only if the state counter of the mask changed."""
+    grid = create_dummy_grid()
+
+    mask = PISM.model.createIceMaskVec(grid)
+
+    def fill(icy):
+        # modify the mask without marking it as modified
+        mask.begin_access()
+        for (i, j) in grid.points_with_ghosts(mask.get_stencil_width()):
+            if icy(i, j):
+                mask[i, j] = PISM.MASK_GROUNDED
+            else:
+                mask[i, j] = PISM.MASK_ICE_FREE_BEDROCK
+        mask.end_access()
+
+    Mx, My = grid.Mx(), grid.My()
+
+    # ice in the left half of the domain
+    fill(lambda i, j: i < Mx / 2)
+    mask.inc_state_counter()
+
+    front = PISM.FrontIndex(grid, 1)
+    front.update(mask)
+    N = PISM.GlobalSum(grid.com, front.size())
+    # cells within one cell of the margin, i.e. two columns
+    assert N == 2 * My
+
+    # no ice at all: the list should not change until the state counter does
+    fill(lambda i, j: False)
+    front.update(mask)
+    assert PISM.GlobalSum(grid.com, front.size()) == N
+
+    mask.inc_state_counter()
+    front.update(mask)
+    assert PISM.GlobalSum(grid.com, front.size()) == 0
+
+def pdd_integrand_table_test():
+    """Test the accuracy of the tabulated integrand used by the PDD model
+    (pdd_tabulate_integrand) over the range of standard deviations and
+    temperatures seen in practice."""
+    import numpy as np
+
+    com = PISM.PETSc.COMM_WORLD
+    system = PISM.UnitSystem("")
+
+    logger = PISM.Logger(com, 2)
+
+    config = PISM.DefaultConfig(com, "pism_config", "-config", system)
+    config.init_with_default(logger)
+    config.set_boolean("pdd_tabulate_integrand", True)
+
+    pdd = PISM.PDDMassBalance(config, system)
+
+    max_error = 0.0
+    for sigma in [0.5, 1.0, 2.0, 2.53, 5.0, 7.5, 10.0]:
+        # includes points in the table, between table points and out of range
+        for T in np.linspace(-60.0, 40.0, 10007):
+            exact = pdd.CalovGreveIntegrand(sigma, T)
+            table = pdd.CalovGreveIntegrand_table(sigma, T)
+            error = abs(table - exact)
+
+            # the bound documented in pism_config.cdl
+            assert error < 2e-11 * sigma, (sigma, T, error)
+
+            max_error = max(max_error, error / sigma)
+
+    print "max. error / sigma:", max_error
+
+    # sigma == 0 is a special case
+    assert pdd.CalovGreveIntegrand_table(0.0, 1.5) == 1.5
+    assert pdd.CalovGreveIntegrand_table(0.0, -1.5) == 0.0
+
+def searise_greenland_row_test():
+    """Test that the row-batched time-series methods of the
+    SeaRISE-Greenland atmosphere model return the same values as the
+    pointwise ones."""
+    import numpy as np
+
+    grid = create_dummy_grid()
+    ctx = grid.ctx()
+    config = ctx.config()
+
+    # spatially-variable inputs
+    precip = PISM.IceModelVec2S()
+    precip.create(grid, "precipitation", PISM.WITHOUT_GHOSTS)
+    precip.set_attrs("climate_state", "precipitation", "m s-1", "")
+
+    usurf = PISM.model.createIceSurfaceVec(grid)
+
+    lat = PISM.IceModelVec2S()
+    lat.create(grid, "lat", PISM.WITHOUT_GHOSTS)
+    lat.set_attrs("mapping", "latitude", "degree_north", "latitude")
+
+    lon = PISM.IceModelVec2S()
+    lon.create(grid, "lon", PISM.WITHOUT_GHOSTS)
+    lon.set_attrs("mapping", "longitude", "degree_east", "longitude")
+
+    with PISM.vec.Access(nocomm=[precip, usurf, lat, lon]):
+        for (i, j) in grid.points():
+            precip[i, j] = 1e-8 * (1 + i + 2 * j)
+            usurf[i, j] = 10.0 * (i + j)
+            lat[i, j] = 60.0 + 0.1 * j
+            lon[i, j] = -45.0 + 0.1 * i
+
+    for v in [usurf, lat, lon]:
+        grid.variables().add(v)
+
+    filename = "searise_greenland_input.nc"
+    pio = PISM.PIO(grid.com, "netcdf3")
+    pio.open(filename, PISM.PISM_READWRITE_MOVE)
+    PISM.define_time(pio, config.get_string("time_dimension_name"),
+                     config.get_string("calendar"),
+                     ctx.time().units_string(),
+                     ctx.unit_system())
+    PISM.append_time(pio, config.get_string("time_dimension_name"),
+                     ctx.time().current())
+    pio.close()
+    precip.write(filename)
+
+    o = PISM.PETSc.Options()
+    o.setValue("-atmosphere_searise_greenland_file", filename)
+
+    model = PISM.AtmosphereSeaRISEGreenland(grid)
+    model.init()
+
+    o.delValue("-atmosphere_searise_greenland_file")
+
+    t = ctx.time().current()
+    dt = PISM.convert(ctx.unit_system(), 1, "year", "seconds")
+    model.update(t, dt)
+
+    N = 12
+    model.init_timeseries([t + k * dt / N for k in range(N)])
+
+    model.begin_pointwise_access()
+    try:
+        ys, ym = grid.ys(), grid.ym()
+        for i in range(grid.xs(), grid.xs() + grid.xm()):
+            P_row = np.array(model.precip_time_series_row(i, N))
+            T_row = np.array(model.temp_time_series_row(i, N))
+            for j in range(ys, ys + ym):
+                P = np.array(model.precip_time_series(i, j, N))
+                T = np.array(model.temp_time_series(i, j, N))
+                k = (j - ys) * N
+                assert np.all(P_row[k:k + N] == P), (i, j)
+                assert np.all(T_row[k:k + N] == T), (i, j)
+    finally:
+        model.end_pointwise_access()
+
+def weighted_ownership_ranges_test():
+    """Test the processor ownership ranges used by the ice-aware domain
+    decomposition: ranges have to cover the grid, be at least min_width
+    wide, and split the total weight evenly."""
+    import numpy as np
+
+    def check(weights, N, min_width):
+        ranges = list(PISM.weighted_ownership_ranges(weights, N, min_width))
+
+        assert len(ranges) == N
+        # cover the grid
+        assert sum(ranges) == len(weights)
+        # each part has at least min_width points, so boundaries are monotone
+        assert min(ranges) >= min_width
+
+        return ranges
+
+    # "icy" points in the first 20% of the domain cost 10 times more
+    M = 100
+    weights = [10.0 if k < 20 else 1.0 for k in range(M)]
+    total = sum(weights)
+
+    for N in [1, 2, 3, 4, 7]:
+        ranges = check(weights, N, 2)
+
+        # the weight of each part is within one point of the average
+        boundaries = np.cumsum([0] + ranges)
+        for k in range(N):
+            part = sum(weights[boundaries[k]:boundaries[k + 1]])
+            assert abs(part - total / N) <= max(weights), (N, ranges)
+
+    # the minimum width takes precedence over balancing
+    weights = [1000.0] + [1.0] * (M - 1)
+    ranges = check(weights, 4, 5)
+    assert ranges[0] == 5
+
+    # equal area distribution if all weights are zero or if the minimum
+    # width cannot be satisfied
+    assert list(PISM.weighted_ownership_ranges([0.0] * 10, 3, 2)) == [4, 3, 3]
+    assert list(PISM.weighted_ownership_ranges([1.0] * 10, 3, 4)) == [4, 3, 3]
+
+
+def ghost_update_skipping_test():
+    """Test that update_ghosts() skips fields that were not modified
+    since the last ghost update and communicates otherwise."""
+    grid = create_dummy_grid()
+    config = grid.ctx().config()
+
+    bed = PISM.model.createBedrockElevationVec(grid)
+    thickness = PISM.model.createIceThicknessVec(grid)
+    surface = PISM.model.createIceSurfaceVec(grid)
+    mask = PISM.model.createIceMaskVec(grid)
+
+    bed.set(-100.0)
+    thickness.set(500.0)
+    for v in [bed, thickness, surface, mask]:
+        v.update_ghosts()
+        assert v.ghosts_are_current()
+
+    # a repeated update of an unchanged field is skipped
+    thickness.update_ghosts()
+    assert thickness.ghosts_are_current()
+
+    # GeometryCalculator::compute() reads bed and thickness (const) and
+    # writes mask and surface using an AccessList
+    gc = PISM.GeometryCalculator(0.0, config)
+    gc.compute(bed, thickness, mask, surface)
+
+    assert bed.ghosts_are_current()
+    assert thickness.ghosts_are_current()
+    assert not mask.ghosts_are_current()
+    assert not surface.ghosts_are_current()
+
+    mask.update_ghosts()
+    assert mask.ghosts_are_current()
+
+    # the caller may modify the Vec returned by get_vec()
+    thickness.get_vec()
+    assert not thickness.ghosts_are_current()
+    thickness.update_ghosts()
+    assert thickness.ghosts_are_current()
+
+    # copy_from() a field without ghosts leaves ghosts of the destination current
+    H = PISM.IceModelVec2S()
+    H.create(grid, "H", PISM.WITHOUT_GHOSTS)
+    H.set(100.0)
+    thickness.copy_from(H)
+    assert thickness.ghosts_are_current()
@@ -0,0 +1,197 @@
+#!/usr/bin/env python
+"""Performance regression test.
+
+Runs one of a fixed set of configurations with the profiling report
+enabled (-profiling_report) and compares the time per model year spent
+in each profiled region (maximum over processors) to a baseline.
+
+Timings depend on the machine, so baselines are recorded on the machine
+running the tests:
+
+  perf_regression.py PISM_PATH MPIEXEC PISM_SOURCE_DIR eismint2 --baselines DIR --record
+
+Each configuration is run --repeat times and the fastest time of each
+region is used, both when recording and when comparing, to reduce the
+influence of other processes running on the same machine.
+
+Without --record the test fails if a region that took at least
+--min_time seconds in the baseline run got slower by more than
+--tolerance (a fraction), or if a region in the baseline is missing.
+"""
+
+import subprocess
+import shlex
+import json
+import os
+import sys
+
+
+def process_arguments():
+    from argparse import ArgumentParser
+    parser = ArgumentParser()
+    parser.add_argument("PISM_PATH")
+    parser.add_argument("MPIEXEC")
+    parser.add_argument("PISM_SOURCE_DIR")
+    parser.add_argument("case", choices=cases.keys())
+    parser.add_argument("--baselines", dest="baselines", default=".",
+                        help="directory containing baseline files")
+    parser.add_argument("--record", dest="record", action="store_true", default=False,
+                        help="record a new baseline instead of comparing")
+    parser.add_argument("-n", dest="N", type=int, default=2,
+                        help="number of MPI processes")
+    parser.add_argument("--repeat", dest="repeat", type=int, default=3,
+                        help="number of runs; the fastest time of each region is used")
+    parser.add_argument("--tolerance", dest="tolerance", type=float, default=0.25,
+                        help="allowed relative slowdown")
+    parser.add_argument("--min_time", dest="min_time", type=float, default=1.0,
+                        help="ignore regions that took less than this (seconds) in the baseline run")
+    parser.add_argument("--input_file", dest="input_file", default=None,
+                        help="input file (needed by the 'greenland' case)")
+
+    return parser.parse_args()
+
+
+def eismint2(opts):
+    "EISMINT II experiment A (SIA, thermomechanically coupled)."
+    years = 1000
+    command = "%s/pisms -eisII A -Mx 61 -My 61 -Mz 61 -y %d" % (opts.PISM_PATH, years)
+    return command, years
+
+
+def mismip(opts):
+    "MISMIP experiment 1a, step 1 (SSA with a grounding line)."
+    sys.path.insert(0, os.path.join(opts.PISM_SOURCE_DIR, "examples/mismip/mismip2d"))
+    import run
+
+    years = 1000
+    step = 1
+    e = run.Experiment("1a", model=1, mode=1)
+
+    input_options, input_file = e.bootstrap_options(step)
+    physics = [o for o in e.physics_options(input_file, step)
+               if not o.startswith(("-ys", "-ye", "-options_left"))]
+
+    command = "%s/pismr %s -ys 0 -ye %d" % (opts.PISM_PATH,
+                                            " ".join(input_options + physics),
+                                            years)
+    return command, years
+
+
+def greenland(opts):
+    "Greenland spin-up on the 20km grid (see examples/std-greenland/spinup.sh)."
+    if opts.input_file is None:
+        print "ERROR: the 'greenland' case requires --input_file (pism_Greenland_5km_v1.1.nc)"
+        sys.exit(1)
+
+    years = 100
+    command = " ".join(["%s/pismr -i %s -bootstrap" % (opts.PISM_PATH, opts.input_file),
+                        "-Mx 76 -My 141 -Mz 101 -Mbz 11 -z_spacing equal -Lz 4000 -Lbz 2000",
+                        "-skip -skip_max 10 -ys -%d -ye 0" % years,
+                        "-atmosphere searise_greenland -surface pdd",
+                        "-calving ocean_kill -ocean_kill_file %s -sia_e 3.0" % opts.input_file,
+                        "-stress_balance ssa+sia -topg_to_phi 15.0,40.0,-300.0,700.0",
+                        "-pseudo_plastic -pseudo_plastic_q 0.25",
+                        "-till_effective_fraction_overburden 0.02"])
+    return command, years
+
+cases = {"eismint2": eismint2,
+         "mismip": mismip,
+         "greenland": greenland}
+
+
+def run_case(opts, report_file):
+    """Runs a case and returns times per model year (in seconds) of
+    profiled regions."""
+
+    command, years = cases[opts.case](opts)
+
+    if os.path.exists(report_file):
+        os.remove(report_file)
+
+    command = "%s -n %d %s -verbose 1 -profiling_report %s -o perf-%s.nc" % (opts.MPIEXEC, opts.N,
+                                                                            command, report_file,
+                                                                            opts.case)
+    print command
+    subprocess.check_call(shlex.split(command))
+
+    # the last line of the report covers the whole run
+    with open(report_file) as f:
+        report = json.loads(f.readlines()[-1])
+
+    result = {}
+    for region in report["regions"]:
+        result[region["name"]] = region["max"] / years
+
+    return years, result
+
+
+def best_of(opts, report_file):
+    """Runs a case opts.repeat times and returns the smallest time per
+    model year of each profiled region."""
+    best = {}
+    for k in range(max(opts.repeat, 1)):
+        years, times = run_case(opts, report_file)
+        for name, t in times.items():
+            best[name] = min(t, best.get(name, t))
+
+    return years, best
+
+
+def compare(opts, baseline, current):
+    """Compares times per model year. Returns the number of regressions
+    (slower or missing regions) found."""
+    years = baseline["model_years"]
+
+    regressions = 0
+    print "%-50s %12s %12s %8s" % ("region", "baseline", "current", "ratio")
+    for name in sorted(baseline["regions"].keys()):
+        old = baseline["regions"][name]
+
+        if name not in current:
+            print "%-50s %12.6f %12s    (not found)  MISSING" % (name, old, "-")
+            regressions += 1
+            continue
+
+        new = current[name]
+        ratio = new / old if old > 0.0 else 1.0
+
+        flag = ""
+        if old * years >= opts.min_time and ratio > 1.0 + opts.tolerance:
+            flag = "  SLOWER"
+            regressions += 1
+
+        print "%-50s %12.6f %12.6f %8.3f%s" % (name, old, new, ratio, flag)
+
+    return regressions
+
+if __name__ == "__main__":
+    opts = process_arguments()
+
+    baseline_file = os.path.join(opts.baselines, "%s-%d.json" % (opts.case, opts.N))
+    report_file = "perf-%s-report.json" % opts.case
+
+    years, times = best_of(opts, report_file)
+
+    if opts.record:
+        with open(baseline_file, "w") as f:
+            json.dump({"case": opts.case,
+                       "processors": opts.N,
+                       "model_years": years,
+                       "regions": times}, f, indent=2, sort_keys=True)
+        print "Recorded the baseline in %s" % baseline_file
+        sys.exit(0)
+
+    if not os.path.exists(baseline_file):
+        print "ERROR: baseline %s not found; use --record to create it" % baseline_file
+        sys.exit(1)
+
+    with open(baseline_file) as f:
+        baseline = json.load(f)
+
+    N = compare(opts, baseline, times)
+    if N > 0:
+        print "ERROR: %d region(s) are missing or more than %d%% slower than the baseline" % (N, opts.tolerance * 100)
+        sys.exit(1)
+
+    os.remove(report_file)
+    sys.exit(0)
@@ -0,0 +1,40 @@
+#!/bin/bash
+
+# Tests that results of the routing hydrology model do not depend on the
+# number of sub-steps per ghost update
+# (hydrology_routing_substeps_per_ghost_update).
+
+PISM_PATH=$1
+MPIEXEC=$2
+PISM_SOURCE_DIR=$3
+
+# List of files to remove when done:
+files="inputforP_regression.nc routing-N1-33.nc routing-N3-33.nc"
+
+rm -f $files
+
+set -e -x
+
+cp $PISM_SOURCE_DIR/test/test_hydrology/inputforP_regression.nc .
+
+OPTS="-i inputforP_regression.nc -bootstrap -Mx 21 -My 21 -Mz 11 -Lz 4000 \
+      -no_mass -energy none -stress_balance none -yield_stress constant \
+      -hydrology routing -hydrology_use_const_bmelt -hydrology_const_bmelt 3.1689e-10 \
+      -hydrology_null_strip 1.0 -y 0.1 -max_dt 0.01 -verbose 1"
+
+for N in 1 3;
+do
+    $MPIEXEC -n 2 $PISM_PATH/pismr $OPTS -hydrology_routing_substeps_per_ghost_update $N \
+             -o routing-N$N-33.nc
+done
+
+set +e
+
+# Check results:
+$PISM_PATH/nccmp.py -t 1e-12 -v bwat,tillwat routing-N1-33.nc routing-N3-33.nc
+if [ $? != 0 ];
+then
+    exit 1
+fi
+
+rm -f $files; exit 0
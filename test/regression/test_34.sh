@@ -0,0 +1,48 @@
+#!/bin/bash
+
+# Tests that the randomized PDD scheme (-pdd_rand_repeatable) gives the
+# same results on 1 and 3 processors (random forcing does not depend on
+# the domain decomposition).
+
+PISM_PATH=$1
+MPIEXEC=$2
+PISM_SOURCE_DIR=$3
+
+# List of files to remove when done:
+files="foo-34.nc atm-34.nc pdd1-34.nc pdd3-34.nc"
+
+rm -f $files
+
+set -e -x
+
+# create a dataset to bootstrap from:
+$PISM_PATH/pisms -Mx 31 -My 31 -Mz 11 -y 100 -verbose 1 -o foo-34.nc
+
+# constant-in-time climate forcing: cold enough for accumulation in the
+# interior, warm enough for (random) melt near the margin
+ncap2 -O -v -s "air_temp = 0.0 * thk + 268.0 - 0.006 * usurf; precipitation = 0.0 * thk + 0.5" \
+      foo-34.nc atm-34.nc
+ncatted -O -a units,air_temp,o,c,"K" -a units,precipitation,o,c,"m year-1" \
+        -a standard_name,air_temp,d,, -a standard_name,precipitation,d,, \
+        -a long_name,air_temp,o,c,"near-surface air temperature" \
+        -a long_name,precipitation,o,c,"ice-equivalent precipitation rate" atm-34.nc
+
+OPTS="-i foo-34.nc -bootstrap -Mx 31 -My 31 -Mz 11 -Lz 5000 -y 10 -verbose 1 \
+      -atmosphere given -atmosphere_given_file atm-34.nc \
+      -surface pdd -pdd_rand_repeatable -o_size medium"
+
+for NN in 1 3;
+do
+    $MPIEXEC -n $NN $PISM_PATH/pismr $OPTS -o pdd$NN-34.nc
+done
+
+set +e
+
+# Check results:
+$PISM_PATH/nccmp.py -v climatic_mass_balance,snow_depth,thk pdd1-34.nc pdd3-34.nc
+if [ $? != 0 ];
+then
+    exit 1
+fi
+
+rm -f $files; exit 0
@@ -0,0 +1,138 @@
+#!/usr/bin/env python
+
+"""Checks the backward Euler water pressure update of the distributed
+hydrology model (-hydrology_implicit_pressure): the solver has to
+converge, the pressure has to stay between zero and the overburden
+pressure, and results have to be close to the ones computed using the
+explicit update."""
+
+import subprocess
+import shutil
+import shlex
+import os
+from sys import exit, argv
+from netCDF4 import Dataset as NC
+import numpy as np
+
+
+def process_arguments():
+    from argparse import ArgumentParser
+    parser = ArgumentParser()
+    parser.add_argument("PISM_PATH")
+    parser.add_argument("MPIEXEC")
+    parser.add_argument("PISM_SOURCE_DIR")
+
+    return parser.parse_args()
+
+
+def copy_input(opts):
+    shutil.copy(os.path.join(opts.PISM_SOURCE_DIR, "test/test_hydrology/inputforP_regression.nc"), ".")
+
+
+def generate_config():
+    """Generates the config file with custom ice softness and hydraulic conductivity (see test_29.py)."""
+
+    print "generating testPconfig.nc ..."
+
+    nc = NC("testPconfig.nc", 'w')
+    pism_overrides = nc.createVariable("pism_overrides", 'b')
+
+    pism_overrides.standard_gravity = 9.81
+    pism_overrides.fresh_water_density = 1000.0
+    pism_overrides.ice_density = 910.0
+    pism_overrides.ice_softness = 3.1689e-24
+    pism_overrides.hydrology_hydraulic_conductivity = 1.0e-2 / (1000.0 * 9.81)
+    pism_overrides.hydrology_tillwat_max = 0.0
+    pism_overrides.hydrology_thickness_power_in_flux = 1.0
+    pism_overrides.hydrology_gradient_power_in_flux = 2.0
+    pism_overrides.hydrology_roughness_scale = 1.0
+    pism_overrides.hydrology_regularizing_porosity = 0.01
+    pism_overrides.yield_stress_model = "constant"
+    pism_overrides.default_tauc = 1e6
+
+    nc.close()
+
+
+def run_pism(opts, output, extra_options=""):
+    cmd = "%s %s/pismr -config_override testPconfig.nc -i inputforP_regression.nc -bootstrap -Mx %d -My %d -Mz 11 -Lz 4000 -hydrology distributed -y 0.01 -max_dt 0.001 -no_mass -energy none -stress_balance ssa+sia -ssa_dirichlet_bc %s -o %s" % (opts.MPIEXEC, opts.PISM_PATH, 21, 21, extra_options, output)
+
+    print cmd
+    # PISM stops with an error if the pressure solver does not converge
+    if subprocess.call(shlex.split(cmd)) != 0:
+        print "PISM failed: %s" % cmd
+        exit(1)
+
+
+def check_bounds(filename):
+    "Check that 0 <= P <= P_overburden."
+    nc = NC(filename)
+
+    P = np.squeeze(nc.variables["bwp"][:])
+    thk = np.squeeze(nc.variables["thk"][:])
+    nc.close()
+
+    P_overburden = 910.0 * 9.81 * thk
+    eps = 1e-6 * np.max(P_overburden)
+
+    if np.min(P) < -eps:
+        print "bwp is negative: min(bwp) = %f" % np.min(P)
+        exit(1)
+
+    excess = np.max(P - P_overburden)
+    if excess > eps:
+        print "bwp exceeds the overburden pressure by up to %f Pa" % excess
+        exit(1)
+
+
+def compare(explicit, implicit):
+    """Compare implicit and explicit results. The two updates differ by
+    O(dt), so we use a relative tolerance."""
+    nc1 = NC(explicit)
+    nc2 = NC(implicit)
+
+    tolerance = 0.05
+
+    for name in ("bwat", "bwp"):
+        var1 = np.squeeze(nc1.variables[name][:])
+        var2 = np.squeeze(nc2.variables[name][:])
+
+        scale = np.max(np.abs(var1))
+        diff = np.max(np.abs(var1 - var2)) / scale
+
+        print "%s: max. relative difference = %f" % (name, diff)
+
+        if diff > tolerance:
+            print "Explicit and implicit results differ too much (%s): %f > %f" % (name, diff, tolerance)
+            exit(1)
+
+    nc1.close()
+    nc2.close()
+
+
+def cleanup():
+    for fname in ("inputforP_regression.nc", "testPconfig.nc", "explicit.nc", "implicit.nc"):
+        os.remove(fname)
+
+if __name__ == "__main__":
+    opts = process_arguments()
+
+    print "Copying input files..."
+    copy_input(opts)
+
+    print "Generating the -config_override file..."
+    generate_config()
+
+    print "Running PISM (explicit pressure update)..."
+    run_pism(opts, "explicit.nc")
+
+    print "Running PISM (implicit pressure update)..."
+    run_pism(opts, "implicit.nc", "-hydrology_implicit_pressure")
+
+    print "Checking pressure bounds..."
+    check_bounds("implicit.nc")
+
+    print "Comparing to the explicit update..."
+    compare("explicit.nc", "implicit.nc")
+
+    print "Cleaning up..."
+    cleanup()
@@ -0,0 +1,125 @@
+#!/usr/bin/env python
+
+"""Checks that using the climate forcing cache
+(-climate_forcing_cache_dir) does not change results: runs PISM with
+time-dependent surface forcing without the cache, with a new cache
+(converting the forcing file) and with the existing cache, and
+compares outputs using nccmp.py."""
+
+import subprocess
+import shutil
+import shlex
+import os
+from sys import exit
+from netCDF4 import Dataset as NC
+import numpy as np
+
+
+def process_arguments():
+    from argparse import ArgumentParser
+    parser = ArgumentParser()
+    parser.add_argument("PISM_PATH")
+    parser.add_argument("MPIEXEC")
+    parser.add_argument("PISM_SOURCE_DIR")
+
+    return parser.parse_args()
+
+
+def run(cmd):
+    print cmd
+    if subprocess.call(shlex.split(cmd)) != 0:
+        print "Command failed: %s" % cmd
+        exit(1)
+
+
+def generate_forcing(input_file, output):
+    """Generates monthly surface mass balance and temperature forcing
+    (one year, with time bounds) on the grid of input_file."""
+
+    print "generating %s ..." % output
+
+    nc_in = NC(input_file)
+    x = nc_in.variables["x"][:]
+    y = nc_in.variables["y"][:]
+    usurf = np.squeeze(nc_in.variables["usurf"][:])
+    nc_in.close()
+
+    year = 365.0 * 86400.0
+    n_records = 12
+
+    nc = NC(output, "w")
+    nc.createDimension("x", len(x))
+    nc.createDimension("y", len(y))
+    nc.createDimension("time", None)
+    nc.createDimension("nv", 2)
+
+    for name, values in (("x", x), ("y", y)):
+        var = nc.createVariable(name, "f8", (name,))
+        var.units = "m"
+        var[:] = values
+
+    time = nc.createVariable("time", "f8", ("time",))
+    time.units = "seconds since 1-1-1"
+    time.calendar = "365_day"
+    time.bounds = "time_bnds"
+
+    time_bnds = nc.createVariable("time_bnds", "f8", ("time", "nv"))
+
+    temp = nc.createVariable("ice_surface_temp", "f8", ("time", "y", "x"))
+    temp.units = "K"
+
+    smb = nc.createVariable("climatic_mass_balance", "f8", ("time", "y", "x"))
+    smb.units = "kg m-2 year-1"
+
+    dt = year / n_records
+    for k in range(n_records):
+        time_bnds[k, :] = [k * dt, (k + 1) * dt]
+        time[k] = (k + 1) * dt
+
+        # seasonal cycle, different in each record
+        season = np.cos(2.0 * np.pi * (k + 0.5) / n_records)
+        temp[k, :, :] = 258.0 - 0.006 * usurf - 10.0 * season
+        smb[k, :, :] = 300.0 - 0.2 * usurf + 100.0 * season
+
+    nc.close()
+
+
+def run_pism(opts, output, extra_options=""):
+    cmd = "%s -n 2 %s/pismr -i foo-36.nc -bootstrap -Mx 31 -My 31 -Mz 11 -Lz 5000 -y 1 -max_dt 0.1 -verbose 1 -surface given -surface_given_file forcing-36.nc %s -o %s" % (opts.MPIEXEC, opts.PISM_PATH, extra_options, output)
+
+    run(cmd)
+
+
+def cleanup():
+    for fname in ("foo-36.nc", "forcing-36.nc", "no_cache-36.nc", "new_cache-36.nc", "old_cache-36.nc"):
+        os.remove(fname)
+    shutil.rmtree("cache-36")
+
+if __name__ == "__main__":
+    opts = process_arguments()
+
+    print "Creating a dataset to bootstrap from..."
+    run("%s/pisms -Mx 31 -My 31 -Mz 11 -y 100 -verbose 1 -o foo-36.nc" % opts.PISM_PATH)
+
+    print "Generating time-dependent surface forcing..."
+    generate_forcing("foo-36.nc", "forcing-36.nc")
+
+    if os.path.exists("cache-36"):
+        shutil.rmtree("cache-36")
+    os.mkdir("cache-36")
+
+    print "Running PISM without the forcing cache..."
+    run_pism(opts, "no_cache-36.nc")
+
+    print "Running PISM, creating the forcing cache..."
+    run_pism(opts, "new_cache-36.nc", "-climate_forcing_cache_dir cache-36")
+
+    print "Running PISM, re-using the forcing cache..."
+    run_pism(opts, "old_cache-36.nc", "-climate_forcing_cache_dir cache-36")
+
+    print "Comparing results..."
+    for output in ("new_cache-36.nc", "old_cache-36.nc"):
+        run("%s/nccmp.py -v thk,enthalpy no_cache-36.nc %s" % (opts.PISM_PATH, output))
+
+    print "Cleaning up..."
+    cleanup()